@@ -0,0 +1,113 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <e-antic/renfxx.h>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "../exact-real/batch.hpp"
+#include "../exact-real/element.hpp"
+#include "../exact-real/integer_ring.hpp"
+#include "../exact-real/module.hpp"
+#include "../exact-real/number_field.hpp"
+#include "../exact-real/rational_field.hpp"
+#include "../exact-real/real_number.hpp"
+#include "../exact-real/seed.hpp"
+
+namespace exactreal::test {
+
+// Return state.range(0) random elements of a module generated by 1 and three
+// random reals.
+template <typename Ring>
+std::vector<Element<Ring>> elements(benchmark::State& state) {
+  const auto module = Module<Ring>::make({
+      RealNumber::rational(1),
+      RealNumber::random(Seed(1)),
+      RealNumber::random(Seed(2)),
+      RealNumber::random(Seed(3))});
+
+  std::vector<Element<Ring>> elements;
+  for (long i = 0; i < state.range(0); i++) {
+    std::vector<typename Ring::ElementClass> coefficients;
+    for (int j = 0; j < module->rank(); j++)
+      coefficients.push_back(rand() % 2048 - 1024);
+    elements.push_back(Element<Ring>(module, coefficients));
+  }
+
+  return elements;
+}
+
+// Decide the orientation of state.range(0) random 2×2 matrices at once.
+template <typename Ring>
+void BatchOrient2d(benchmark::State& state) {
+  const auto a = elements<Ring>(state);
+  const auto b = elements<Ring>(state);
+  const auto c = elements<Ring>(state);
+  const auto d = elements<Ring>(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch::orient2d(a, b, c, d));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Decide the orientation of state.range(0) random 2×2 matrices one by one
+// for comparison with BatchOrient2d.
+template <typename Ring>
+void BatchOrient2dNaive(benchmark::State& state) {
+  const auto a = elements<Ring>(state);
+  const auto b = elements<Ring>(state);
+  const auto c = elements<Ring>(state);
+  const auto d = elements<Ring>(state);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < a.size(); i++)
+      benchmark::DoNotOptimize((a[i] * d[i] - b[i] * c[i]).sign());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Decide the sign of state.range(0) random elements at once.
+template <typename Ring>
+void BatchSign(benchmark::State& state) {
+  const auto x = elements<Ring>(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch::sign(x));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BatchOrient2d, IntegerRing)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchOrient2d, RationalField)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchOrient2d, NumberField)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchOrient2dNaive, IntegerRing)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchOrient2dNaive, RationalField)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchOrient2dNaive, NumberField)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchSign, IntegerRing)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchSign, RationalField)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BatchSign, NumberField)->RangeMultiplier(8)->Range(64, 4096);
+
+}  // namespace exactreal::test
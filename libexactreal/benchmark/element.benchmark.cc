@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "../exact-real/arb.hpp"
 #include "../exact-real/element.hpp"
@@ -30,6 +31,7 @@
 #include "../exact-real/number_field.hpp"
 #include "../exact-real/rational_field.hpp"
 #include "../exact-real/real_number.hpp"
+#include "../exact-real/yap/arb.hpp"
 
 namespace exactreal::test {
 
@@ -136,6 +138,14 @@ class ElementBenchmark : public benchmark::Fixture {
     }
   }
 
+  void lt(benchmark::State& state) {
+    const auto [lhs, rhs] = elements(state);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(lhs < rhs);
+    }
+  }
+
   void arb(benchmark::State& state) {
     const auto [element, __] = elements(state);
     (void)__;
@@ -145,6 +155,66 @@ class ElementBenchmark : public benchmark::Fixture {
     }
   }
 
+  // Evaluate the element term by term as Element::arb did before it used
+  // arb_dot, for comparison with arb().
+  void arbNaive(benchmark::State& state) {
+    const auto [element, __] = elements(state);
+    (void)__;
+
+    const auto& basis = element.module()->basis();
+    const auto coefficients = element.coefficients();
+
+    for (auto _ : state) {
+      Arb ret;
+      for (size_t i = 0; i < basis.size(); i++) {
+        const Arb term = Ring::arb(coefficients[i], ARB_PRECISION_FAST);
+        ret += (basis[i]->arb(ARB_PRECISION_FAST) * term)(ARB_PRECISION_FAST);
+      }
+      benchmark::DoNotOptimize(ret);
+    }
+  }
+
+  void det2(benchmark::State& state) {
+    const auto [lhs, rhs] = elements(state);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(exactreal::det2(lhs, rhs, rhs, lhs));
+    }
+  }
+
+  // Compute the determinant with intermediate products, for comparison with
+  // det2().
+  void det2Naive(benchmark::State& state) {
+    const auto [lhs, rhs] = elements(state);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(lhs * lhs - rhs * rhs);
+    }
+  }
+
+  void power(benchmark::State& state) {
+    const auto [element, __] = elements(state);
+    (void)__;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(element.pow(16));
+    }
+  }
+
+  // Compute the power by repeated multiplication, for comparison with
+  // power().
+  void powerNaive(benchmark::State& state) {
+    const auto [element, __] = elements(state);
+    (void)__;
+
+    for (auto _ : state) {
+      Element<Ring> power = element;
+      for (int i = 1; i < 16; i++)
+        power *= element;
+      benchmark::DoNotOptimize(power);
+    }
+  }
+
   void nonzero(benchmark::State& state) {
     const auto [element, __] = elements(state);
     (void)__;
@@ -164,6 +234,17 @@ class ElementBenchmark : public benchmark::Fixture {
     // elements x^3*y^4 + …, and x^1*y^2 + …
     b->Args({2, 3, 4, 1, 2});
   }
+
+  static void BenchmarkedManyVariables(benchmark::internal::Benchmark* b) {
+    BenchmarkedDegrees(b);
+
+    // elements with many generators, x_1^2*…*x_n^2 + …, and the same again
+    for (long vars : {4, 8, 16}) {
+      std::vector<long> args{vars};
+      args.resize(1 + 2 * vars, 2);
+      b->Args(args);
+    }
+  }
 };
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, addition_Z, IntegerRing)
@@ -180,15 +261,15 @@ BENCHMARK_REGISTER_F(ElementBenchmark, addition_K)->Apply(ElementBenchmark<Numbe
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, multiplication_Z, IntegerRing)
 (benchmark::State& state) { multiplication(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedManyVariables);
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, multiplication_Q, RationalField)
 (benchmark::State& state) { multiplication(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedManyVariables);
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, multiplication_K, NumberField)
 (benchmark::State& state) { multiplication(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, multiplication_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedManyVariables);
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, square_Z, IntegerRing)
 (benchmark::State& state) { square(state); }
@@ -226,16 +307,135 @@ BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, floordiv_K, NumberField)
 (benchmark::State& state) { floordiv(state); }
 BENCHMARK_REGISTER_F(ElementBenchmark, floordiv_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
 
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, lt_Z, IntegerRing)
+(benchmark::State& state) { lt(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, lt_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, lt_Q, RationalField)
+(benchmark::State& state) { lt(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, lt_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, lt_K, NumberField)
+(benchmark::State& state) { lt(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, lt_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2_Z, IntegerRing)
+(benchmark::State& state) { det2(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2Naive_Z, IntegerRing)
+(benchmark::State& state) { det2Naive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2Naive_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2_Q, RationalField)
+(benchmark::State& state) { det2(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2Naive_Q, RationalField)
+(benchmark::State& state) { det2Naive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2Naive_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2_K, NumberField)
+(benchmark::State& state) { det2(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, det2Naive_K, NumberField)
+(benchmark::State& state) { det2Naive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, det2Naive_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, power_Z, IntegerRing)
+(benchmark::State& state) { power(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, power_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, powerNaive_Z, IntegerRing)
+(benchmark::State& state) { powerNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, powerNaive_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, power_Q, RationalField)
+(benchmark::State& state) { power(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, power_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, powerNaive_Q, RationalField)
+(benchmark::State& state) { powerNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, powerNaive_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, power_K, NumberField)
+(benchmark::State& state) { power(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, power_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, powerNaive_K, NumberField)
+(benchmark::State& state) { powerNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, powerNaive_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
+
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arb_Z, IntegerRing)
 (benchmark::State& state) { arb(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, arb_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, arb_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arbNaive_Z, IntegerRing)
+(benchmark::State& state) { arbNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, arbNaive_Z)->Apply(ElementBenchmark<IntegerRing>::BenchmarkedManyVariables);
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arb_Q, RationalField)
 (benchmark::State& state) { arb(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, arb_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, arb_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arbNaive_Q, RationalField)
+(benchmark::State& state) { arbNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, arbNaive_Q)->Apply(ElementBenchmark<RationalField>::BenchmarkedManyVariables);
 
 BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arb_K, NumberField)
 (benchmark::State& state) { arb(state); }
-BENCHMARK_REGISTER_F(ElementBenchmark, arb_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedDegrees);
+BENCHMARK_REGISTER_F(ElementBenchmark, arb_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedManyVariables);
+
+BENCHMARK_TEMPLATE_DEFINE_F(ElementBenchmark, arbNaive_K, NumberField)
+(benchmark::State& state) { arbNaive(state); }
+BENCHMARK_REGISTER_F(ElementBenchmark, arbNaive_K)->Apply(ElementBenchmark<NumberField>::BenchmarkedManyVariables);
+
+// Return state.range(0) elements that each live in their own module
+// generated by 1 and a random real.
+template <typename Ring>
+std::vector<Element<Ring>> summands(benchmark::State& state) {
+  std::vector<Element<Ring>> summands;
+  for (long i = 0; i < state.range(0); i++) {
+    const auto module = Module<Ring>::make({RealNumber::rational(1), RealNumber::random()});
+    summands.push_back(Element<Ring>(module, {rand() % 1024 + 1, rand() % 1024 + 1}));
+  }
+  return summands;
+}
+
+// Sum up state.range(0) elements from distinct modules at once.
+template <typename Ring>
+void Sum(benchmark::State& state) {
+  const auto elements = summands<Ring>(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sum(begin(elements), end(elements)));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Sum up state.range(0) elements from distinct modules one by one, for
+// comparison with Sum.
+template <typename Ring>
+void SumNaive(benchmark::State& state) {
+  const auto elements = summands<Ring>(state);
+
+  for (auto _ : state) {
+    Element<Ring> total;
+    for (const auto& element : elements)
+      total += element;
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(Sum, IntegerRing)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(Sum, RationalField)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(Sum, NumberField)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(SumNaive, IntegerRing)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(SumNaive, RationalField)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(SumNaive, NumberField)->RangeMultiplier(8)->Range(8, 4096);
 
 }  // namespace exactreal::test
@@ -0,0 +1,128 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <e-antic/renfxx.h>
+
+#include <memory>
+#include <vector>
+
+#include "../exact-real/integer_ring.hpp"
+#include "../exact-real/module.hpp"
+#include "../exact-real/number_field.hpp"
+#include "../exact-real/rational_field.hpp"
+#include "../exact-real/real_number.hpp"
+#include "../exact-real/seed.hpp"
+
+namespace exactreal::test {
+
+// Return random reals that are shared by all benchmarks and threads.
+const std::vector<std::shared_ptr<const RealNumber>>& reals() {
+  static const auto reals = []() {
+    std::vector<std::shared_ptr<const RealNumber>> reals;
+    for (unsigned int seed = 0; seed < 1024; seed++)
+      reals.push_back(RealNumber::random(Seed(seed)));
+    return reals;
+  }();
+
+  return reals;
+}
+
+// Create modules of rank state.range(0) from several threads at once. Each
+// thread walks through a different window of generators, so this mixes
+// lookups of existing modules with the creation of new ones.
+template <typename Ring>
+void ModuleMake(benchmark::State& state) {
+  const auto& gens = reals();
+  const auto rank = static_cast<size_t>(state.range(0));
+
+  size_t offset = static_cast<size_t>(state.thread_index()) * 64;
+  typename Module<Ring>::Basis basis(rank);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < rank; i++)
+      basis[i] = gens[(offset + i) % gens.size()];
+
+    benchmark::DoNotOptimize(Module<Ring>::make(basis));
+
+    offset = (offset + 1) % gens.size();
+  }
+}
+
+BENCHMARK_TEMPLATE(ModuleMake, IntegerRing)->Arg(2)->Arg(16)->Arg(512)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(ModuleMake, RationalField)->Arg(2)->Arg(16)->Arg(512)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(ModuleMake, NumberField)->Arg(2)->Arg(16)->Arg(512)->ThreadRange(1, 16)->UseRealTime();
+
+// Return rank generators of degree two, i.e., products of the shared random
+// reals. Different values of offset and stride produce different bases.
+Module<IntegerRing>::Basis products(size_t rank, size_t offset, size_t stride) {
+  const auto& gens = reals();
+
+  Module<IntegerRing>::Basis basis;
+  for (size_t i = 0; i < rank; i++)
+    basis.push_back(*gens[(offset + i) % gens.size()] * *gens[(offset + i + stride) % gens.size()]);
+  return basis;
+}
+
+// Compute the span of two modules of rank state.range(0) that share half of
+// their generators.
+template <typename Ring>
+void ModuleSpan(benchmark::State& state) {
+  const auto rank = static_cast<size_t>(state.range(0));
+
+  size_t iteration = 0;
+  for (auto _ : state) {
+    // Spans are cached, so we use new modules in every iteration.
+    state.PauseTiming();
+    const size_t offset = iteration % reals().size();
+    const size_t stride = 1 + iteration / reals().size();
+    const auto lhs = Module<Ring>::make(products(rank, offset, stride));
+    const auto rhs = Module<Ring>::make(products(rank, offset + rank / 2, stride));
+    iteration++;
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(Module<Ring>::span(lhs, rhs));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_TEMPLATE(ModuleSpan, IntegerRing)->RangeMultiplier(4)->Range(4, 256)->Complexity();
+BENCHMARK_TEMPLATE(ModuleSpan, RationalField)->RangeMultiplier(4)->Range(4, 256)->Complexity();
+
+// Decide whether a module of rank state.range(0) is a submodule of a module
+// of twice that rank.
+template <typename Ring>
+void ModuleSubmodule(benchmark::State& state) {
+  const auto rank = static_cast<size_t>(state.range(0));
+
+  const auto module = Module<Ring>::make(products(rank, 0, 1));
+  const auto supermodule = Module<Ring>::make(products(2 * rank, 0, 1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(module->submodule(*supermodule));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_TEMPLATE(ModuleSubmodule, IntegerRing)->RangeMultiplier(4)->Range(4, 256)->Complexity();
+BENCHMARK_TEMPLATE(ModuleSubmodule, RationalField)->RangeMultiplier(4)->Range(4, 256)->Complexity();
+
+}  // namespace exactreal::test
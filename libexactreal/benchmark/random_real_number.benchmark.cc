@@ -22,8 +22,10 @@
 
 #include <memory>
 
+#include "../exact-real/arb.hpp"
 #include "../exact-real/arf.hpp"
 #include "../exact-real/real_number.hpp"
+#include "../exact-real/seed.hpp"
 
 namespace exactreal::test {
 
@@ -47,4 +49,63 @@ BENCHMARK_DEFINE_F(RandomRealNumberFixture, arf)
 
 BENCHMARK_REGISTER_F(RandomRealNumberFixture, arf)->Range(16, 1 << 16);
 
+// Read approximations of the same random real from several threads at once.
+// Once the most precise approximation has been computed, all reads are served
+// from the cache without taking any locks.
+BENCHMARK_DEFINE_F(RandomRealNumberFixture, arfConcurrent)
+(benchmark::State& state) {
+  const auto prec = static_cast<unsigned int>(state.range(0));
+  rnd->arf(1 << 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rnd->arf(prec));
+  }
+
+  // Reads per second grow with the number of threads if readers do not
+  // contend on shared memory.
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(RandomRealNumberFixture, arfConcurrent)->Arg(64)->Arg(1 << 10)->Arg(1 << 16)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_DEFINE_F(RandomRealNumberFixture, arbConcurrent)
+(benchmark::State& state) {
+  const auto prec = static_cast<unsigned int>(state.range(0));
+  rnd->arf(1 << 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rnd->arb(prec));
+  }
+
+  // Reads per second grow with the number of threads if readers do not
+  // contend on shared memory.
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(RandomRealNumberFixture, arbConcurrent)->Arg(64)->Arg(1 << 10)->ThreadRange(1, 16)->UseRealTime();
+
+struct PhiloxRandomRealNumberFixture : benchmark::Fixture {
+  std::shared_ptr<const RealNumber> rnd = RealNumber::random(Seed(1337, Seed::Generator::PHILOX));
+};
+
+BENCHMARK_DEFINE_F(PhiloxRandomRealNumberFixture, arf)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rnd->arf(static_cast<unsigned int>(state.range(0))));
+  }
+}
+
+BENCHMARK_REGISTER_F(PhiloxRandomRealNumberFixture, arf)->Range(16, 1 << 16);
+
+// Approximate a new random real in every iteration, i.e., measure the cost of
+// producing its digits.
+template <Seed::Generator generator>
+void RandomRealNumberDigits(benchmark::State& state) {
+  unsigned int seed = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RealNumber::random(Seed(seed++, generator))->arf(static_cast<unsigned int>(state.range(0))));
+  }
+}
+
+BENCHMARK_TEMPLATE(RandomRealNumberDigits, Seed::Generator::RAND48)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(RandomRealNumberDigits, Seed::Generator::PHILOX)->Range(16, 1 << 16);
+
 }  // namespace exactreal::test
@@ -0,0 +1,54 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <gmpxx.h>
+
+#include <memory>
+#include <vector>
+
+#include "../exact-real/real_number.hpp"
+
+namespace exactreal::test {
+
+// Intern many rationals that have the same double approximation, i.e.,
+// 1 + i/2^80. If the factory hashed them by their double value, they would
+// all collide.
+void RationalNearby(benchmark::State& state) {
+  const auto count = state.range(0);
+
+  mpq_class denominator = mpz_class(1) << 80;
+
+  for (auto _ : state) {
+    // Keep the rationals alive so the factory has to tell them apart.
+    std::vector<std::shared_ptr<const RealNumber>> rationals;
+    rationals.reserve(static_cast<size_t>(count));
+
+    for (long i = 0; i < count; i++)
+      rationals.push_back(RealNumber::rational(1 + mpq_class(i) / denominator));
+
+    benchmark::DoNotOptimize(rationals);
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(RationalNearby)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
+
+}  // namespace exactreal::test
@@ -0,0 +1,128 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_ARB_VECTOR_HPP
+#define LIBEXACTREAL_ARB_VECTOR_HPP
+
+#include <flint/flint.h>
+
+#if __FLINT_RELEASE < 30000
+#include <arb.h>
+#else
+#include <flint/arb.h>
+#endif
+
+#include <iosfwd>
+
+#include "arb.hpp"
+
+namespace exactreal {
+
+/// A wrapper for vectors of \rst{:c:type:`arb_t`} elements as created by
+/// \rst{:c:func:`_arb_vec_init`} so we get C++ style memory management.
+///
+///     #include <exact-real/arb_vector.hpp>
+///     exactreal::ArbVector v(2);
+///     v.set(0, exactreal::Arb(1));
+///     v.set(1, exactreal::Arb(2));
+///     v
+///     // -> [1.00000, 2.00000]
+///
+/// The entries are stored contiguously so they can be passed to the vector
+/// functions of Arb directly.
+///
+/// \note Like \ref Arb, this class should really be implemented by FLINT
+/// itself.
+class LIBEXACTREAL_API ArbVector {
+ public:
+  /// Create an empty vector.
+  ///
+  ///     exactreal::ArbVector empty;
+  ///     empty.size()
+  ///     // -> 0
+  ///
+  ArbVector() noexcept;
+
+  /// Create a vector of `size` exact zeros.
+  ///
+  ///     exactreal::ArbVector zeros(3);
+  ///     zeros
+  ///     // -> [0, 0, 0]
+  ///
+  explicit ArbVector(size_t size);
+
+  ArbVector(const ArbVector&);
+  ArbVector(ArbVector&&) noexcept;
+
+  ~ArbVector() noexcept;
+
+  ArbVector& operator=(const ArbVector&);
+  ArbVector& operator=(ArbVector&&) noexcept;
+
+  /// Return the number of entries of this vector.
+  size_t size() const noexcept;
+
+  /// Return a copy of the entry at position `i`.
+  ///
+  ///     v[0]
+  ///     // -> 1.00000
+  ///
+  Arb operator[](size_t i) const;
+
+  /// Set the entry at position `i` to `value`.
+  ///
+  ///     v.set(0, exactreal::Arb(1337));
+  ///     v[0]
+  ///     // -> 1337.00
+  ///
+  void set(size_t i, const Arb& value);
+
+  /// Return the dot product of this vector with `other` computed with a
+  /// single rounding to `prec` bits, see \rst{:c:func:`arb_dot`.}
+  ///
+  ///     exactreal::ArbVector w(2);
+  ///     w.set(0, exactreal::Arb(2));
+  ///     v.dot(w, 64)
+  ///     // -> 2674.00
+  ///
+  Arb dot(const ArbVector& other, prec) const;
+
+  /// Return a pointer to the underlying entries for use with the vector
+  /// functions of Arb.
+  ///
+  ///     _arb_vec_zero(v.arb_ptr(), v.size());
+  ///     v
+  ///     // -> [0, 0]
+  ///
+  ::arb_ptr arb_ptr() noexcept;
+
+  /// Return a pointer to the underlying entries for use with the vector
+  /// functions of Arb.
+  ::arb_srcptr arb_ptr() const noexcept;
+
+  friend std::ostream& operator<<(std::ostream&, const ArbVector&) LIBEXACTREAL_API;
+
+ private:
+  ::arb_ptr entries;
+  size_t length;
+};
+
+}  // namespace exactreal
+
+#endif
@@ -0,0 +1,87 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_BATCH_HPP
+#define LIBEXACTREAL_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "forward.hpp"
+
+/// Operations on many elements at once.
+///
+/// These operations first decide all items with double precision arithmetic
+/// on enclosures of the elements, which is much faster than deciding the
+/// items one by one. Only the items that cannot be decided like this are
+/// then decided with exact arithmetic.
+///
+/// The operations are fastest if the elements come from a few modules only.
+namespace exactreal::batch {
+
+/// Return the signs of the `size` elements starting at `elements`, i.e., the
+/// result of calling \ref Element::sign on each of them.
+///
+///     #include <exact-real/batch.hpp>
+///     #include <exact-real/element.hpp>
+///     #include <exact-real/module.hpp>
+///     #include <exact-real/rational_field.hpp>
+///     #include <exact-real/real_number.hpp>
+///
+///     auto M = exactreal::Module<exactreal::RationalField>::make({
+///       exactreal::RealNumber::rational(1),
+///       exactreal::RealNumber::random()});
+///     std::vector elements{M->gen(0), -M->gen(1), M->zero()};
+///     exactreal::batch::sign(elements.data(), elements.size())
+///     // -> { 1, -1, 0 }
+///
+template <typename Ring>
+std::vector<int> sign(const Element<Ring>* elements, size_t size);
+
+/// Return the signs of the elements, see above.
+///
+///     exactreal::batch::sign<exactreal::RationalField>({M->gen(0), -M->gen(1), M->zero()})
+///     // -> { 1, -1, 0 }
+///
+template <typename Ring>
+std::vector<int> sign(const std::vector<Element<Ring>>& elements);
+
+/// Return the signs of the determinants a[i]*d[i] - b[i]*c[i] for i <
+/// `size`, e.g., the orientations of the pairs of vectors (a[i], b[i]) and
+/// (c[i], d[i]).
+///
+///     const auto one = M->gen(0);
+///     const auto x = M->gen(1);
+///     exactreal::batch::orient2d(&one, &x, &x, &one, 1)
+///     // -> { 1 }
+///
+template <typename Ring>
+std::vector<int> orient2d(const Element<Ring>* a, const Element<Ring>* b, const Element<Ring>* c, const Element<Ring>* d, size_t size);
+
+/// Return the signs of the determinants a[i]*d[i] - b[i]*c[i], see above.
+///
+///     exactreal::batch::orient2d<exactreal::RationalField>({M->gen(0)}, {M->gen(1)}, {M->gen(1)}, {M->gen(0)})
+///     // -> { 1 }
+///
+template <typename Ring>
+std::vector<int> orient2d(const std::vector<Element<Ring>>& a, const std::vector<Element<Ring>>& b, const std::vector<Element<Ring>>& c, const std::vector<Element<Ring>>& d);
+
+}  // namespace exactreal::batch
+
+#endif
@@ -28,7 +28,10 @@
 #include <boost/mp11/utility.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <e-antic/renfxx_fwd.hpp>
+#include <functional>
+#include <iterator>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "external/spimpl/spimpl.h"
@@ -358,6 +361,39 @@ class LIBEXACTREAL_API Element
   ///     // -> 0
   ///
   mpz_class floordiv(const Element&) const;
+
+  /// Add the product of the arguments to this element.
+  ///
+  /// This is equivalent to `*this += a * b` but does not create the product
+  /// as an intermediate element.
+  ///
+  ///     auto M = exactreal::Module<exactreal::RationalField>::make({
+  ///       exactreal::RealNumber::rational(1),
+  ///       exactreal::RealNumber::random()});
+  ///     auto a = exactreal::Element<exactreal::RationalField>(M, {1, 1});
+  ///     auto b = exactreal::Element<exactreal::RationalField>(M, {2, 0});
+  ///     a.fma(b, b)
+  ///     // -> ℝ(<...>) + 5
+  ///
+  Element& fma(const Element& a, const Element& b);
+
+  /// Return this element raised to the power \p exponent.
+  ///
+  /// Elements with one or two non-zero terms are expanded directly with the
+  /// binomial theorem, other elements are raised to the power by repeated
+  /// squaring.
+  ///
+  ///     auto M = exactreal::Module<exactreal::RationalField>::make({
+  ///       exactreal::RealNumber::rational(1),
+  ///       exactreal::RealNumber::random()});
+  ///     auto a = exactreal::Element<exactreal::RationalField>(M, {1, 1});
+  ///     a.pow(3)
+  ///     // -> ℝ(<...>)^3 + 3*ℝ(<...>)^2 + 3*ℝ(<...>) + 1
+  ///
+  ///     a.pow(0)
+  ///     // -> 1
+  ///
+  Element pow(unsigned int exponent) const;
   ///@}
 
   /// Return the product of this element with the given generator.
@@ -462,6 +498,29 @@ class LIBEXACTREAL_API Element
   ///
   mpz_class ceil() const;
 
+  /// Return the sign of this element, i.e., -1 if it is negative, 0 if it
+  /// is zero, and 1 if it is positive.
+  ///
+  ///     auto M = exactreal::Module<exactreal::RationalField>::make({
+  ///       exactreal::RealNumber::rational(1),
+  ///       exactreal::RealNumber::random()});
+  ///     auto a = exactreal::Element<exactreal::RationalField>(M, {-2, 1});
+  ///     a.sign()
+  ///     // -> -1
+  ///
+  int sign() const;
+
+  /// Return how often the sign of an element, or the sign of the difference
+  /// of two operands in a comparison, could be decided quickly with double
+  /// precision arithmetic and how often this was inconclusive, so that we
+  /// had to fall back to ball arithmetic, since the start of this process.
+  ///
+  /// This is meant as a diagnostic for performance problems.
+  ///
+  ///     auto [decided, undecided] = exactreal::Element<exactreal::RationalField>::filterStatistics();
+  ///
+  static std::pair<size_t, size_t> filterStatistics();
+
   /// Return whether this element is a unit, i.e., whether its inverse exists in
   /// the parent module.
   ///
@@ -682,6 +741,20 @@ class LIBEXACTREAL_API Element
   template <typename R>
   friend std::ostream& operator<<(std::ostream&, const Element<R>&);
 
+  template <typename R>
+  friend struct BatchKernel;
+
+  friend struct std::hash<Element>;
+
+  template <typename R>
+  friend Element<R> det2(const Element<R>&, const Element<R>&, const Element<R>&, const Element<R>&);
+
+  template <typename R>
+  friend Element<R> linear_combination(const std::vector<Element<R>>&, const std::vector<Element<R>>&);
+
+  template <typename R>
+  friend Element<R> sum(const std::vector<std::reference_wrapper<const Element<R>>>&);
+
  private:
   struct LIBEXACTREAL_LOCAL Implementation;
   spimpl::impl_ptr<Implementation> impl;
@@ -707,6 +780,70 @@ Element(const RealNumber&)->Element<IntegerRing>;
 template <typename R>
 LIBEXACTREAL_API std::ostream& operator<<(std::ostream&, const Element<R>&);
 
+/// Return the determinant a*d - b*c of the 2×2 matrix with rows (a, b) and
+/// (c, d).
+///
+/// The result is computed without creating the products as intermediate
+/// elements.
+///
+///     auto M = exactreal::Module<exactreal::RationalField>::make({
+///       exactreal::RealNumber::rational(1),
+///       exactreal::RealNumber::random()});
+///     auto a = exactreal::Element<exactreal::RationalField>(M, {1, 1});
+///     auto b = exactreal::Element<exactreal::RationalField>(M, {2, 0});
+///     exactreal::det2(a, b, b, a)
+///     // -> ℝ(<...>)^2 + 2*ℝ(<...>) - 3
+///
+template <typename Ring>
+LIBEXACTREAL_API Element<Ring> det2(const Element<Ring>& a, const Element<Ring>& b, const Element<Ring>& c, const Element<Ring>& d);
+
+/// Return the sum of the products coefficients[i] * elements[i].
+///
+/// The result is created in a single module and its coefficients are
+/// written in a single pass, so this is much faster than summing up the
+/// products one by one.
+///
+///     exactreal::linear_combination<exactreal::RationalField>({a, b}, {b, a})
+///     // -> 4*ℝ(<...>) + 4
+///
+template <typename Ring>
+LIBEXACTREAL_API Element<Ring> linear_combination(const std::vector<Element<Ring>>& coefficients, const std::vector<Element<Ring>>& elements);
+
+/// Return the sum of the summands.
+///
+/// The result is created in the span of the modules of the summands which is
+/// determined at once, so this is much faster than summing up the summands
+/// one by one when they live in many different modules.
+///
+/// Usually, it is more convenient to call the variant of this function that
+/// takes a range of elements.
+template <typename Ring>
+LIBEXACTREAL_API Element<Ring> sum(const std::vector<std::reference_wrapper<const Element<Ring>>>& summands);
+
+/// Return the sum of the elements in the range [begin, end).
+///
+///     auto M = exactreal::Module<exactreal::RationalField>::make({
+///       exactreal::RealNumber::rational(1),
+///       exactreal::RealNumber::random()});
+///     auto N = exactreal::Module<exactreal::RationalField>::make({
+///       exactreal::RealNumber::rational(1),
+///       exactreal::RealNumber::random()});
+///     std::vector<exactreal::Element<exactreal::RationalField>> summands{M->gen(0), M->gen(1), N->gen(1)};
+///     auto s = exactreal::sum(begin(summands), end(summands));
+///     s
+///     // -> ℝ(<...>) + ℝ(<...>) + 1
+///
+///     *s.module()
+///     // -> ℚ-Module(1, ℝ(<...>), ℝ(<...>))
+///
+template <typename Iterator>
+auto sum(Iterator begin, Iterator end) {
+  using Summand = typename std::iterator_traits<Iterator>::value_type;
+
+  std::vector<std::reference_wrapper<const Summand>> summands(begin, end);
+  return sum(summands);
+}
+
 }  // namespace exactreal
 
 namespace std {
@@ -27,7 +27,9 @@
 #define LIBEXACTREAL_EXACT_REAL_HPP
 
 #include "arb.hpp"
+#include "arb_vector.hpp"
 #include "arf.hpp"
+#include "batch.hpp"
 #include "element.hpp"
 #include "integer_ring.hpp"
 #include "module.hpp"
@@ -40,6 +40,7 @@ struct ArbExpr;
 }  // namespace yap
 
 class Arb;
+class ArbVector;
 class Arf;
 
 class RealNumber;
@@ -22,6 +22,7 @@
 #define LIBEXACTREAL_MODULE_HPP
 
 #include <boost/operators.hpp>
+#include <optional>
 #include <vector>
 
 #include "external/spimpl/spimpl.h"
@@ -133,6 +134,22 @@ class LIBEXACTREAL_API Module
   ///
   const Basis& basis() const;
 
+  /// Return the position of \p gen in the \ref basis of this module or
+  /// nothing if \p gen is not a generator of this module.
+  ///
+  /// The lookup runs in constant time on average.
+  ///
+  ///     auto x = exactreal::RealNumber::random();
+  ///     auto M = exactreal::Module<exactreal::RationalField>::make({
+  ///       exactreal::RealNumber::rational(1), x});
+  ///     *M->index(*x)
+  ///     // -> 1
+  ///
+  ///     M->index(*exactreal::RealNumber::rational(2)).has_value()
+  ///     // -> false
+  ///
+  std::optional<size> index(const RealNumber& gen) const;
+
   /// Return the i-th generator of this module.
   ///
   ///     auto M = exactreal::Module<exactreal::RationalField>::make({
@@ -190,6 +207,9 @@ class LIBEXACTREAL_API Module
   struct LIBEXACTREAL_LOCAL Implementation;
   spimpl::unique_impl_ptr<Implementation> impl;
 
+  template <typename R>
+  friend class Element;
+
   Module(spimpl::unique_impl_ptr<Implementation>&&) LIBEXACTREAL_LOCAL;
 };
 
@@ -149,6 +149,17 @@ class LIBEXACTREAL_API RealNumber
   ///
   virtual Arf arf(long prec) const = 0;
 
+  /// Limit the memory used to cache approximations of real numbers.
+  ///
+  /// Each real number keeps its most precise approximation returned by \ref
+  /// arf if it needs at most \p perReal bytes. Less precise approximations
+  /// are derived from it. If the cached approximations of all real numbers
+  /// need more than \p total bytes, the least recently used ones are dropped.
+  ///
+  /// By default, a real number uses at most 1MB and all real numbers together
+  /// use at most 64MB.
+  static void approximationCacheLimits(size_t perReal, size_t total);
+
   /// Return an \ref Arb with \p prec bits of relative accuracy which contains
   /// this number, i.e., the returned value satisfies
   /// `arb_rel_accuracy_bits(x.arb_t()) == prec`.
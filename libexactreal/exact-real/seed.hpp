@@ -29,12 +29,30 @@ namespace exactreal {
 /// reproducible and deterministic.
 class LIBEXACTREAL_API Seed {
   public:
+  /// The pseudo-random number generators that can produce the digits of a
+  /// random real number.
+  enum class Generator {
+    /// The rand48 linear congruential generator which produces one binary
+    /// digit at a time. This is the default for compatibility with random
+    /// reals that have been created (and serialized) by earlier versions of
+    /// exact-real.
+    RAND48,
+    /// A counter-based Philox generator which produces 64 binary digits at a
+    /// time and can produce any block of digits directly without producing
+    /// the preceding digits.
+    PHILOX,
+  };
+
+  class Stream;
+
   /// Create a random seed that is different from any previously
   /// generated random seed in this process.
   ///
   /// \note This seed is not really random. It's just a global counter so you
   /// are going to see the same seeds in an otherwise deterministic use of
-  /// exact-real.
+  /// exact-real. When creating seeds from several threads, the seeds each
+  /// thread gets depend on scheduling; use \ref stream to get reproducible
+  /// seeds in each thread instead.
   /// 
   ///     #include <exact-real/seed.hpp>
   ///     const exactreal::Seed seed;
@@ -46,8 +64,67 @@ class LIBEXACTREAL_API Seed {
   /// Create a fixed seed with value \p seed.
   Seed(unsigned int seed);
 
+  /// Create a fixed seed with value \p seed for the random number
+  /// \p generator.
+  ///
+  ///     #include <exact-real/real_number.hpp>
+  ///     const auto x = exactreal::RealNumber::random(exactreal::Seed(1337, exactreal::Seed::Generator::PHILOX));
+  ///     *x
+  ///     // -> ℝ(0.779317…)
+  ///
+  Seed(unsigned int seed, Generator generator);
+
+  /// Create a fixed seed with value \p seed in the \p substream of the
+  /// random number \p generator.
+  ///
+  /// Only the \ref Generator::PHILOX generator supports substreams other
+  /// than 0.
+  Seed(unsigned int seed, Generator generator, unsigned int substream);
+
+  /// Return the stream of seeds with index \p index.
+  ///
+  /// The seeds of a stream are deterministic and distinct from the seeds of
+  /// any other stream and from the seeds created by the other constructors.
+  /// So parallel jobs that each use their own stream, e.g., one per thread,
+  /// create the same random reals in every run without coordinating.
+  ///
+  ///     #include <exact-real/seed.hpp>
+  ///     auto stream = exactreal::Seed::stream(1);
+  ///     const exactreal::Seed seed = stream();
+  ///     seed.value
+  ///     // -> 0
+  ///
+  ///     seed.substream
+  ///     // -> 2
+  ///
+  static Stream stream(unsigned int index);
+
   /// The underlying value used as a seed in random number generators.
   unsigned int value;
+
+  /// The random number generator that this seed is meant for.
+  Generator generator;
+
+  /// The substream of the random number generator, i.e., 0 for the seeds
+  /// created by \ref Seed(), and 1 + index for the seeds of \ref stream.
+  unsigned int substream;
+};
+
+/// A deterministic sequence of seeds, see \ref Seed::stream.
+///
+/// A stream must not be used by several threads at the same time.
+class LIBEXACTREAL_API Seed::Stream {
+ public:
+  /// Return the next seed in this stream.
+  Seed operator()();
+
+ private:
+  friend class Seed;
+
+  explicit Stream(unsigned int index);
+
+  unsigned int index;
+  unsigned int next;
 };
 
 }  // namespace exactreal
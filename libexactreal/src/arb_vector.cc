@@ -0,0 +1,100 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../exact-real/arb_vector.hpp"
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <ostream>
+#include <utility>
+
+#include "util/assert.ipp"
+
+using boost::numeric_cast;
+
+namespace exactreal {
+
+ArbVector::ArbVector() noexcept : entries(nullptr), length(0) {}
+
+ArbVector::ArbVector(size_t size) : entries(size ? _arb_vec_init(numeric_cast<slong>(size)) : nullptr), length(size) {}
+
+// Note that the length of an existing vector fits into an slong since this
+// has been checked when it was created.
+
+ArbVector::ArbVector(const ArbVector& other) : ArbVector(other.length) {
+  _arb_vec_set(entries, other.entries, static_cast<slong>(length));
+}
+
+ArbVector::ArbVector(ArbVector&& other) noexcept : entries(std::exchange(other.entries, nullptr)), length(std::exchange(other.length, 0)) {}
+
+ArbVector::~ArbVector() noexcept {
+  if (entries)
+    _arb_vec_clear(entries, static_cast<slong>(length));
+}
+
+ArbVector& ArbVector::operator=(const ArbVector& other) {
+  if (this != &other)
+    *this = ArbVector(other);
+  return *this;
+}
+
+ArbVector& ArbVector::operator=(ArbVector&& other) noexcept {
+  std::swap(entries, other.entries);
+  std::swap(length, other.length);
+  return *this;
+}
+
+size_t ArbVector::size() const noexcept { return length; }
+
+Arb ArbVector::operator[](size_t i) const {
+  LIBEXACTREAL_CHECK_ARGUMENT(i < length, "index out of range");
+
+  Arb ret;
+  arb_set(ret.arb_t(), entries + i);
+  return ret;
+}
+
+void ArbVector::set(size_t i, const Arb& value) {
+  LIBEXACTREAL_CHECK_ARGUMENT(i < length, "index out of range");
+
+  arb_set(entries + i, value.arb_t());
+}
+
+Arb ArbVector::dot(const ArbVector& other, prec prec) const {
+  LIBEXACTREAL_CHECK_ARGUMENT(length == other.length, "vectors must have the same length");
+
+  Arb ret;
+  arb_dot(ret.arb_t(), nullptr, 0, entries, 1, other.entries, 1, static_cast<slong>(length), prec);
+  return ret;
+}
+
+::arb_ptr ArbVector::arb_ptr() noexcept { return entries; }
+
+::arb_srcptr ArbVector::arb_ptr() const noexcept { return entries; }
+
+std::ostream& operator<<(std::ostream& os, const ArbVector& self) {
+  os << "[";
+  for (size_t i = 0; i < self.size(); i++) {
+    if (i)
+      os << ", ";
+    os << self[i];
+  }
+  return os << "]";
+}
+
+}  // namespace exactreal
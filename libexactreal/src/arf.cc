@@ -30,6 +30,8 @@
 
 #include <ostream>
 
+#include "external/hash-combine/hash.hpp"
+
 using std::ostream;
 using std::string;
 
@@ -225,7 +227,27 @@ void swap(Arf& a, Arf& b) {
 namespace std {
 
 size_t hash<exactreal::Arf>::operator()(const exactreal::Arf& self) const {
-  return hash<double>()(static_cast<double>(self));
+  using flatsurf::hash_combine;
+
+  const arf_struct* x = self.arf_t();
+
+  // The representation of an arf_t is canonical: the mantissa is normalized
+  // and its least significant limb is non-zero. Special values have an empty
+  // mantissa and are distinguished by their exponent.
+  const fmpz* exponent = ARF_EXPREF(x);
+  size_t ret = hash_combine(static_cast<size_t>(ARF_SGNBIT(x)), static_cast<size_t>(fmpz_fits_si(exponent) ? fmpz_get_si(exponent) : static_cast<slong>(fmpz_bits(exponent))));
+
+  if (arf_is_special(x))
+    return ret;
+
+  mp_srcptr limbs;
+  mp_size_t size;
+  ARF_GET_MPN_READONLY(limbs, size, x);
+
+  for (mp_size_t i = 0; i < size; i++)
+    ret = hash_combine(ret, static_cast<size_t>(limbs[i]));
+
+  return ret;
 }
 
 }  // namespace std
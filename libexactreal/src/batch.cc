@@ -0,0 +1,180 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../exact-real/batch.hpp"
+
+#include <e-antic/renfxx.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "../exact-real/element.hpp"
+#include "../exact-real/integer_ring.hpp"
+#include "../exact-real/module.hpp"
+#include "../exact-real/number_field.hpp"
+#include "../exact-real/rational_field.hpp"
+#include "impl/double_enclosure.hpp"
+#include "impl/element.hpp"
+#include "util/assert.ipp"
+
+namespace exactreal {
+
+template <typename Ring>
+struct BatchKernel {
+  /// Enclosures of many numbers by doubles as a structure of arrays, i.e.,
+  /// the ith number is enclosed by values[i] ± errors[i].
+  struct Enclosures {
+    explicit Enclosures(size_t size) : values(size), errors(size) {}
+
+    DoubleEnclosure operator[](size_t i) const { return {values[i], errors[i]}; }
+
+    std::vector<double> values;
+    std::vector<double> errors;
+  };
+
+  /// Return enclosures of the elements by doubles.
+  static Enclosures enclose(const Element<Ring>* elements, size_t size) {
+    Enclosures ret(size);
+
+    // Elements of the same module are enclosed together, one generator at a
+    // time, so the inner loops run over contiguous arrays of doubles.
+    std::unordered_map<const Module<Ring>*, std::vector<size_t>> modules;
+    for (size_t i = 0; i < size; i++)
+      modules[elements[i].impl->parent.get()].push_back(i);
+
+    for (const auto& [module, items] : modules) {
+      const auto& generators = Element<Ring>::Implementation::doubles(*module);
+
+      Enclosures sums(items.size());
+      Enclosures coefficients(items.size());
+
+      for (size_t j = 0; j < generators.size(); j++) {
+        for (size_t k = 0; k < items.size(); k++) {
+          const auto coefficient = DoubleEnclosure::enclose(elements[items[k]].impl->coefficients[j]);
+          coefficients.values[k] = coefficient.value;
+          coefficients.errors[k] = coefficient.error;
+        }
+
+        accumulate(sums, coefficients, generators[j]);
+      }
+
+      for (size_t k = 0; k < items.size(); k++) {
+        ret.values[items[k]] = sums.values[k];
+        ret.errors[items[k]] = sums.errors[k];
+      }
+    }
+
+    return ret;
+  }
+
+  /// Add coefficients * generator to sums.
+  ///
+  /// This loop has no branches so the compiler can vectorize it.
+  static void accumulate(Enclosures& sums, const Enclosures& coefficients, const DoubleEnclosure& generator) {
+    const size_t size = sums.values.size();
+
+    double* values = sums.values.data();
+    double* errors = sums.errors.data();
+    const double* coefficientValues = coefficients.values.data();
+    const double* coefficientErrors = coefficients.errors.data();
+
+    for (size_t k = 0; k < size; k++) {
+      const auto sum = DoubleEnclosure{values[k], errors[k]} + DoubleEnclosure{coefficientValues[k], coefficientErrors[k]} * generator;
+      values[k] = sum.value;
+      errors[k] = sum.error;
+    }
+  }
+
+  static std::vector<int> sign(const Element<Ring>* elements, size_t size) {
+    const auto enclosures = enclose(elements, size);
+
+    std::vector<int> signs(size);
+    for (size_t i = 0; i < size; i++) {
+      const auto sign = enclosures[i].sign();
+      signs[i] = sign ? *sign : elements[i].sign();
+    }
+
+    return signs;
+  }
+
+  static std::vector<int> orient2d(const Element<Ring>* a, const Element<Ring>* b, const Element<Ring>* c, const Element<Ring>* d, size_t size) {
+    const auto A = enclose(a, size);
+    const auto B = enclose(b, size);
+    const auto C = enclose(c, size);
+    const auto D = enclose(d, size);
+
+    std::vector<int> signs(size);
+    for (size_t i = 0; i < size; i++) {
+      const auto sign = (A[i] * D[i] - B[i] * C[i]).sign();
+      signs[i] = sign ? *sign : (a[i] * d[i] - b[i] * c[i]).sign();
+    }
+
+    return signs;
+  }
+};
+
+namespace batch {
+
+template <typename Ring>
+std::vector<int> sign(const Element<Ring>* elements, size_t size) {
+  return BatchKernel<Ring>::sign(elements, size);
+}
+
+template <typename Ring>
+std::vector<int> sign(const std::vector<Element<Ring>>& elements) {
+  return BatchKernel<Ring>::sign(elements.data(), elements.size());
+}
+
+template <typename Ring>
+std::vector<int> orient2d(const Element<Ring>* a, const Element<Ring>* b, const Element<Ring>* c, const Element<Ring>* d, size_t size) {
+  return BatchKernel<Ring>::orient2d(a, b, c, d, size);
+}
+
+template <typename Ring>
+std::vector<int> orient2d(const std::vector<Element<Ring>>& a, const std::vector<Element<Ring>>& b, const std::vector<Element<Ring>>& c, const std::vector<Element<Ring>>& d) {
+  LIBEXACTREAL_CHECK_ARGUMENT(a.size() == b.size() && a.size() == c.size() && a.size() == d.size(), "number of entries of the matrices must match");
+
+  return BatchKernel<Ring>::orient2d(a.data(), b.data(), c.data(), d.data(), a.size());
+}
+
+}  // namespace batch
+
+}  // namespace exactreal
+
+// Explicit instantiations of templates so that code is generated for the
+// linker.
+namespace exactreal::batch {
+
+template std::vector<int> sign(const Element<IntegerRing>*, size_t);
+template std::vector<int> sign(const Element<RationalField>*, size_t);
+template std::vector<int> sign(const Element<NumberField>*, size_t);
+
+template std::vector<int> sign(const std::vector<Element<IntegerRing>>&);
+template std::vector<int> sign(const std::vector<Element<RationalField>>&);
+template std::vector<int> sign(const std::vector<Element<NumberField>>&);
+
+template std::vector<int> orient2d(const Element<IntegerRing>*, const Element<IntegerRing>*, const Element<IntegerRing>*, const Element<IntegerRing>*, size_t);
+template std::vector<int> orient2d(const Element<RationalField>*, const Element<RationalField>*, const Element<RationalField>*, const Element<RationalField>*, size_t);
+template std::vector<int> orient2d(const Element<NumberField>*, const Element<NumberField>*, const Element<NumberField>*, const Element<NumberField>*, size_t);
+
+template std::vector<int> orient2d(const std::vector<Element<IntegerRing>>&, const std::vector<Element<IntegerRing>>&, const std::vector<Element<IntegerRing>>&, const std::vector<Element<IntegerRing>>&);
+template std::vector<int> orient2d(const std::vector<Element<RationalField>>&, const std::vector<Element<RationalField>>&, const std::vector<Element<RationalField>>&, const std::vector<Element<RationalField>>&);
+template std::vector<int> orient2d(const std::vector<Element<NumberField>>&, const std::vector<Element<NumberField>>&, const std::vector<Element<NumberField>>&, const std::vector<Element<NumberField>>&);
+
+}  // namespace exactreal::batch
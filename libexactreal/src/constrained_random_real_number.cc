@@ -40,7 +40,7 @@
 #include "../exact-real/seed.hpp"
 #include "../exact-real/yap/arf.hpp"
 #include "external/hash-combine/hash.hpp"
-#include "external/unique-factory/unique-factory/unique-factory.hpp"
+#include "impl/concurrent_unique_factory.hpp"
 #include "impl/real_number_base.hpp"
 #include "util/assert.ipp"
 
@@ -60,10 +60,10 @@ auto& factory() {
   struct Hash {
     size_t operator()(const Key& key) const {
       using flatsurf::hash_combine, flatsurf::hash;
-      return hash_combine(hash(std::get<0>(key)), hash(std::get<1>(key)), hash(static_cast<double>(*std::get<2>(key))));
+      return hash_combine(hash(std::get<0>(key)), hash(std::get<1>(key)), RealNumberBase::id(*std::get<2>(key)));
     }
   };
-  static unique_factory::UniqueFactory<Key, RealNumber, unique_factory::KeepNothingAlive, Hash> factory;
+  static ConcurrentUniqueFactory<Key, RealNumber, Hash> factory;
   return factory;
 }
 
@@ -21,6 +21,7 @@
 #include "../exact-real/element.hpp"
 
 #include <flint/flint.h>
+#include <flint/fmpz.h>
 
 #if __FLINT_RELEASE < 30000
 #include <arb.h>
@@ -29,21 +30,35 @@
 #endif
 #include <e-antic/renfxx.h>
 
+#include <algorithm>
+#include <atomic>
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 #include <map>
 #include <set>
 
+#include "../exact-real/arb_vector.hpp"
 #include "../exact-real/module.hpp"
 #include "../exact-real/real_number.hpp"
 #include "../exact-real/yap/arb.hpp"
 #include "external/gmpxxll/gmpxxll/mpz_class.hpp"
+#include "external/hash-combine/hash.hpp"
+#include "impl/division.hpp"
+#include "impl/double_enclosure.hpp"
+#include "impl/element.hpp"
+#include "impl/gmp_hash.hpp"
+#include "impl/module.hpp"
+#include "impl/real_number_base.hpp"
+#include "impl/refinement.hpp"
 #include "util/assert.ipp"
 
+#ifdef LIBEXACTREAL_FMPZ_MPOLY
+#include "impl/fmpz_mpoly.hpp"
+#endif
+
 using namespace exactreal;
 using boost::numeric_cast;
-using std::find_if;
 using std::logic_error;
 using std::map;
 using std::set;
@@ -51,73 +66,149 @@ using std::shared_ptr;
 using std::vector;
 
 namespace {
-template <typename Ring>
-class ElementImplementation {
- public:
-  ElementImplementation() : ElementImplementation(Module<Ring>::make({})) {}
+template <typename Ring, typename RHS>
+bool lt(const Element<Ring>& lhs, const RHS& rhs) {
+  if (lhs == rhs)
+    return false;
 
-  explicit ElementImplementation(const shared_ptr<const Module<Ring>>& parent)
-      : ElementImplementation(parent, vector<typename Ring::ElementClass>(parent->rank())) {}
+  // Decide the sign of lhs - rhs. This terminates since the difference is
+  // non-zero.
+  return Refinement<Ring>::compare(lhs, rhs).decide([](const Arb& difference) { return difference < 0; });
+}
 
-  ElementImplementation(const shared_ptr<const Module<Ring>>& parent, const vector<typename Ring::ElementClass>& coefficients)
-      : parent(parent), coefficients(coefficients) {
-    LIBEXACTREAL_ASSERT(static_cast<size>(coefficients.size()) == parent->rank(), "Number of Coefficients " << coefficients.size() << " does not match rank of module " << parent->rank());
-  }
+template <typename Ring, typename RHS>
+bool gt(const Element<Ring>& lhs, const RHS& rhs) {
+  if (lhs == rhs)
+    return false;
+  return !lt(lhs, rhs);
+}
 
-  template <typename T>
-  ElementImplementation& operator*=(const T& rhs) {
-    for (auto& c : coefficients)
-      Ring::imul(c, rhs);
+/// The number of times a sign could be decided with the double filter and
+/// the number of times we had to fall back to ball arithmetic.
+template <typename Ring>
+struct FilterStatistics {
+  static inline std::atomic<size_t> decided = 0;
+  static inline std::atomic<size_t> undecided = 0;
+};
 
-    return *this;
-  }
+/// Return the sign of the number enclosed by x if the enclosure suffices to
+/// determine it.
+template <typename Ring>
+std::optional<int> filter(const DoubleEnclosure& x) {
+  const auto sign = x.sign();
+  if (sign)
+    FilterStatistics<Ring>::decided.fetch_add(1, std::memory_order_relaxed);
+  else
+    FilterStatistics<Ring>::undecided.fetch_add(1, std::memory_order_relaxed);
+  return sign;
+}
 
-  template <typename T>
-  ElementImplementation& operator/=(const T& rhs) {
-    for (auto& c : coefficients)
-      Ring::idiv(c, rhs);
+/// Return whether lhs < rhs where difference encloses lhs - rhs.
+template <typename Ring, typename RHS>
+bool lt(const Element<Ring>& lhs, const RHS& rhs, const DoubleEnclosure& difference) {
+  if (const auto sign = filter<Ring>(difference))
+    return *sign < 0;
+  return lt(lhs, rhs);
+}
 
-    return *this;
+/// Return whether lhs > rhs where difference encloses lhs - rhs.
+template <typename Ring, typename RHS>
+bool gt(const Element<Ring>& lhs, const RHS& rhs, const DoubleEnclosure& difference) {
+  if (const auto sign = filter<Ring>(difference))
+    return *sign > 0;
+  return gt(lhs, rhs);
+}
+
+/// Return an enclosure of a rational number or integer by doubles.
+template <typename T>
+DoubleEnclosure enclose(const T& x) {
+  return DoubleEnclosure::enclose(x);
+}
+
+/// Return a hash of the integer x that only depends on its value.
+size_t coefficientHash(const mpz_class& x) {
+  return GmpHash()(x);
+}
+
+/// Return a hash of the rational x that only depends on its value.
+size_t coefficientHash(const mpq_class& x) {
+  return GmpHash()(x);
+}
+
+/// Return a hash of the FLINT integer x that only depends on its value.
+size_t fmpzHash(const fmpz* x) {
+  if (COEFF_IS_MPZ(*x))
+    return GmpHash()(COEFF_TO_PTR(*x));
+  return flatsurf::hash(static_cast<slong>(*x));
+}
+
+/// Return a hash of the number field element x that only depends on its
+/// value.
+///
+/// We hash the canonical coordinates of x in its number field without
+/// allocating. Equal elements in different number fields can only occur
+/// when they are rational (since we only form composita with the rationals)
+/// and then their coordinates are the same rational in all number fields, as
+/// long as we ignore the trailing zero coordinates.
+size_t coefficientHash(const eantic::renf_elem_class& x) {
+  using flatsurf::hash_combine;
+
+  const nf_struct* nf = x.parent().renf_t()->nf;
+  const nf_elem_struct* elem = x.renf_elem_t()->elem;
+
+  const fmpz* num;
+  const fmpz* den;
+  slong length;
+  if (nf->flag & NF_LINEAR) {
+    num = LNF_ELEM_NUMREF(elem);
+    den = LNF_ELEM_DENREF(elem);
+    length = 1;
+  } else if (nf->flag & NF_QUADRATIC) {
+    num = QNF_ELEM_NUMREF(elem);
+    den = QNF_ELEM_DENREF(elem);
+    length = 2;
+  } else {
+    num = NF_ELEM_NUMREF(elem);
+    den = NF_ELEM_DENREF(elem);
+    length = NF_ELEM(elem)->length;
   }
 
-  shared_ptr<const Module<Ring>> parent;
-  vector<typename Ring::ElementClass> coefficients;
-};
+  while (length > 0 && fmpz_is_zero(num + length - 1))
+    length--;
 
-template <typename Ring, typename RHS>
-bool lt(const Element<Ring>& lhs, const RHS& rhs) {
-  if (lhs == rhs)
-    return false;
-  for (long prec = ARB_PRECISION_FAST;; prec *= 2) {
-    Arb self = lhs.arb(prec);
-    std::optional<bool> lt;
-    if constexpr (std::is_same_v<RHS, Element<Ring>> || std::is_same_v<RHS, RealNumber>) {
-      Arb other = rhs.arb(prec);
-      lt = self < other;
-    } else {
-      lt = self < rhs;
-    }
-    if (lt.has_value()) {
-      return *lt;
-    }
-  }
+  size_t ret = fmpzHash(den);
+  for (slong i = 0; i < length; i++)
+    ret = hash_combine(ret, fmpzHash(num + i));
+
+  return ret;
 }
 
-template <typename Ring, typename RHS>
-bool gt(const Element<Ring>& lhs, const RHS& rhs) {
-  if (lhs == rhs)
-    return false;
-  return !(lhs < rhs);
+/// Return the number of non-zero coefficients.
+template <typename T>
+size_t support(const std::vector<T>& coefficients) {
+  return static_cast<size_t>(std::count_if(begin(coefficients), end(coefficients), [](const T& c) { return c != 0; }));
+}
+
+/// Return x^n for n > 0 by binary exponentiation where multiply(a, b)
+/// returns the product of a and b.
+template <typename T, typename Multiply>
+T power(T x, unsigned int n, const Multiply& multiply) {
+  LIBEXACTREAL_ASSERT(n > 0, "exponent must be positive");
+
+  std::optional<T> ret;
+  while (true) {
+    if (n & 1)
+      ret = ret ? multiply(*ret, x) : x;
+    n >>= 1;
+    if (n == 0)
+      return *ret;
+    x = multiply(x, x);
+  }
 }
 
 }  // namespace
 
 namespace exactreal {
-template <typename Ring>
-struct Element<Ring>::Implementation : public ElementImplementation<Ring> {
-  using ElementImplementation<Ring>::ElementImplementation;
-};
-
 template <typename Ring>
 Element<Ring>::Element() : impl(spimpl::make_impl<Element<Ring>::Implementation>()) {}
 
@@ -195,9 +286,16 @@ Arb Element<Ring>::arb(long accuracy) const {
   long prec = accuracy + numeric_cast<long>(ceil(log2(numeric_cast<double>(impl->parent->rank()))));
 
   while (true) {
-    Arb ret;
-    for (int i = 0; i < impl->parent->rank(); i++)
-      ret += (impl->parent->basis()[i]->arb(prec) * Ring::arb(impl->coefficients[i], prec))(prec);
+    const auto gens = Module<Ring>::Implementation::arbs(*impl->parent, prec);
+
+    ArbVector coefficients(gens->size());
+    for (size_t i = 0; i < gens->size(); i++) {
+      if (impl->coefficients[i])
+        coefficients.set(i, Ring::arb(impl->coefficients[i], prec));
+    }
+
+    // Evaluate the linear combination with a single rounding.
+    const Arb ret = gens->dot(coefficients, prec);
 
     if (arb_rel_accuracy_bits(ret.arb_t()) >= accuracy)
       return ret;
@@ -210,7 +308,16 @@ template <typename Ring>
 Element<Ring>& Element<Ring>::operator+=(const Element<Ring>& rhs) {
   if (impl->parent != rhs.impl->parent) {
     auto parent = Module<Ring>::span(this->impl->parent, rhs.impl->parent);
-    return promote(parent) += Element<Ring>(rhs).promote(parent);
+    const auto embedding = Module<Ring>::Implementation::embedding(rhs.impl->parent, parent);
+
+    promote(parent);
+
+    for (size_t j = 0; j < embedding->size(); j++) {
+      LIBEXACTREAL_ASSERT((*embedding)[j] != Module<Ring>::Implementation::NONE, "span of modules must contain all their generators");
+      impl->coefficients[(*embedding)[j]] += parent->ring().coerce(rhs.impl->coefficients[j]);
+    }
+
+    return *this;
   } else {
     for (int i = 0; i < impl->parent->rank(); i++) {
       impl->coefficients[i] += rhs.impl->coefficients[i];
@@ -233,35 +340,38 @@ Element<Ring>& Element<Ring>::operator*=(const Element<Ring>& rhs) {
 
   if (this->module()->ring() != rhs.module()->ring()) {
     auto compositum = Ring::compositum(this->module()->ring(), rhs.module()->ring());
-    return this->promote(Module<Ring>::make(this->module()->basis(), compositum)) *=
-           Element<Ring>(rhs).promote(Module<Ring>::make(rhs.module()->basis(), compositum));
+    return this->promote(Module<Ring>::Implementation::make(this->module()->basis(), compositum, false)) *=
+           Element<Ring>(rhs).promote(Module<Ring>::Implementation::make(rhs.module()->basis(), compositum, false));
   }
 
-  map<shared_ptr<const RealNumber>, typename Ring::ElementClass> products;
-
-  for (size_t i = 0; i < impl->parent->basis().size(); i++) {
-    for (size_t j = 0; j < rhs.impl->parent->basis().size(); j++) {
-      auto gen = *impl->parent->basis()[i] * *rhs.impl->parent->basis()[j];
-      auto value = impl->coefficients[i] * rhs.impl->coefficients[j];
+  const auto [parent, multiplication] = Module<Ring>::Implementation::multiplication(impl->parent, rhs.impl->parent);
 
-      products[gen] += value;
+#ifdef LIBEXACTREAL_FMPZ_MPOLY
+  if constexpr (FmpzMpoly<Ring>::supported) {
+    if (FmpzMpoly<Ring>::worthwhile(support(impl->coefficients), support(rhs.impl->coefficients))) {
+      if (auto coefficients = FmpzMpoly<Ring>::multiply(*this, rhs, *parent)) {
+        this->impl->parent = parent;
+        this->impl->coefficients = std::move(*coefficients);
+        return *this;
+      }
     }
   }
+#endif
 
-  vector<std::pair<shared_ptr<const RealNumber>, typename Ring::ElementClass>> sorted(begin(products), end(products));
-  std::sort(begin(sorted), end(sorted), [](const auto& lhs, const auto& rhs) { return lhs.first->deglex(*rhs.first); });
+  const size_t lhs_rank = impl->coefficients.size();
+  const size_t rhs_rank = rhs.impl->coefficients.size();
 
-  vector<shared_ptr<const RealNumber>> basis;
-  vector<typename Ring::ElementClass> coefficients;
-  for (auto& v : sorted) {
-    basis.push_back(v.first);
-    coefficients.push_back(v.second);
+  vector<typename Ring::ElementClass> coefficients(parent->basis().size());
+  for (size_t i = 0; i < lhs_rank; i++) {
+    if (!impl->coefficients[i])
+      continue;
+    const size_t* slots = &multiplication->slots[i * rhs_rank];
+    for (size_t j = 0; j < rhs_rank; j++)
+      coefficients[slots[j]] += impl->coefficients[i] * rhs.impl->coefficients[j];
   }
 
-  this->impl->parent = Module<Ring>::make(basis, this->impl->parent->ring());
-  this->impl->coefficients = coefficients;
-
-  LIBEXACTREAL_ASSERT(this->impl->parent->basis() == basis, "order of generators in module is not deglex which is the assumption by Element::operator/=");
+  this->impl->parent = parent;
+  this->impl->coefficients = std::move(coefficients);
 
   return *this;
 }
@@ -427,41 +537,16 @@ std::optional<Element<Ring>> Element<Ring>::truediv(const Element<Ring>& rhs) co
     return Element<Ring>(*this).promote(parent).truediv(Element<Ring>(rhs).promote(parent));
   }
 
-  // Multivariate polynomial division.
-  Element<Ring> remainder = *this;
-  Element<Ring> quotient = this->module()->zero();
-
-  const auto leading = [](const auto& x) {
-    const auto coefficients = x.coefficients();
-    for (size_t i = coefficients.size(); i > 0; i--) {
-      if (coefficients[i - 1])
-        return std::tuple(coefficients[i - 1], x.module()->basis()[i - 1]);
-    }
-    throw std::logic_error("zero element has no leading coefficient");
-  };
-
-  while (remainder) {
-    auto [a, g] = leading(remainder);
-    auto [b, h] = leading(rhs);
-
-    auto generator_quotient = *g / *h;
-    if (!generator_quotient.has_value())
-      return std::nullopt;
-
-    typename Ring::ElementClass coefficient_quotient = a / b;
-
-    if (coefficient_quotient * b != a) {
-      LIBEXACTREAL_ASSERT(!Ring::isField, "division of coefficients must be exact in fields");
-      return std::nullopt;
+#ifdef LIBEXACTREAL_FMPZ_MPOLY
+  if constexpr (FmpzMpoly<Ring>::supported) {
+    if (FmpzMpoly<Ring>::worthwhile(support(impl->coefficients), support(rhs.impl->coefficients))) {
+      if (auto quotient = FmpzMpoly<Ring>::divide(*this, rhs))
+        return *quotient;
     }
-
-    auto partial_quotient = coefficient_quotient * Module<Ring>::make({*generator_quotient}, this->module()->ring())->gen(0);
-
-    quotient += partial_quotient;
-    remainder -= partial_quotient * rhs;
   }
+#endif
 
-  return quotient;
+  return Division<Ring>::divide(*this, rhs);
 }
 
 template <typename Ring>
@@ -504,21 +589,134 @@ mpz_class Element<Ring>::floordiv(const Element<Ring>& rhs) const {
   if (exact)
     return *exact;
 
+  Refinement<Ring> dividend(*this);
+  Refinement<Ring> divisor(rhs);
+
   for (long prec = ARB_PRECISION_FAST;; prec *= 2) {
-    const auto div = rhs.arb(prec);
-    if (!(div != 0))
-      // the divident ball contains zero
+    if (!(divisor.arb() != 0)) {
+      // the divisor ball contains zero
+      divisor.refine();
       continue;
+    }
 
-    const Arb quotient = (arb(prec) / div)(prec);
+    const Arb quotient = (dividend.arb() / divisor.arb())(prec);
 
     const auto [lower, upper] = static_cast<std::pair<Arf, Arf>>(quotient);
 
     if (lower.floor() == upper.floor())
       return lower.floor();
+
+    dividend.refine();
+    divisor.refine();
   }
 }
 
+template <typename Ring>
+Element<Ring> Element<Ring>::pow(unsigned int exponent) const {
+  if (exponent == 0)
+    return Module<Ring>::make({RealNumber::rational(1)}, impl->parent->ring())->one();
+
+  if (exponent == 1 || !*this)
+    return *this;
+
+  using C = typename Ring::ElementClass;
+  using Generator = std::shared_ptr<const RealNumber>;
+
+  const auto multiplyCoefficients = [](const C& lhs, const C& rhs) { return C(lhs * rhs); };
+  const auto multiplyGenerators = [](const Generator& lhs, const Generator& rhs) { return *lhs * *rhs; };
+
+  std::vector<size_t> support;
+  for (size_t i = 0; i < impl->coefficients.size(); i++)
+    if (impl->coefficients[i])
+      support.push_back(i);
+
+  const auto& basis = impl->parent->basis();
+
+  if (support.size() == 1) {
+    // (c·g)^n = c^n·g^n
+    const auto i = support[0];
+    return Element<Ring>(
+        Module<Ring>::make({power(basis[i], exponent, multiplyGenerators)}, impl->parent->ring()),
+        {power(impl->coefficients[i], exponent, multiplyCoefficients)});
+  }
+
+  if (support.size() == 2) {
+    // (a·g + b·h)^n = Σ binomial(n, k)·a^k·b^(n-k)·g^k·h^(n-k)
+    const auto& a = impl->coefficients[support[0]];
+    const auto& b = impl->coefficients[support[1]];
+    const auto& g = basis[support[0]];
+    const auto& h = basis[support[1]];
+
+    // The powers of the coefficients and generators; the zeroth powers are
+    // never used.
+    std::vector<C> as{a}, bs{b};
+    std::vector<Generator> gs{g}, hs{h};
+    for (unsigned int k = 1; k < exponent; k++) {
+      as.push_back(as.back() * a);
+      bs.push_back(bs.back() * b);
+      gs.push_back(*gs.back() * *g);
+      hs.push_back(*hs.back() * *h);
+    }
+
+    std::vector<std::pair<Generator, C>> terms;
+    for (unsigned int k = 0; k <= exponent; k++) {
+      Generator generator = k == 0 ? hs[exponent - 1] : k == exponent ? gs[exponent - 1] : *gs[k - 1] * *hs[exponent - k - 1];
+      C coefficient = k == 0 ? bs[exponent - 1] : k == exponent ? as[exponent - 1] : C(as[k - 1] * bs[exponent - k - 1]);
+
+      mpz_class binomial;
+      mpz_bin_uiui(binomial.get_mpz_t(), exponent, k);
+      Ring::imul(coefficient, binomial);
+
+      terms.emplace_back(std::move(generator), std::move(coefficient));
+    }
+
+    // Create the module with its generators sorted so that the coefficients
+    // are in the right order.
+    std::sort(begin(terms), end(terms), [](const auto& lhs, const auto& rhs) { return lhs.first->deglex(*rhs.first); });
+
+    typename Module<Ring>::Basis generators;
+    std::vector<C> coefficients;
+    for (auto& [generator, coefficient] : terms) {
+      generators.push_back(std::move(generator));
+      coefficients.push_back(std::move(coefficient));
+    }
+
+    return Element<Ring>(Module<Ring>::make(generators, impl->parent->ring()), coefficients);
+  }
+
+  // Each squaring and multiplication goes through the cached multiplication
+  // tables of pairs of modules, so we only create O(log n) product modules.
+  return power(*this, exponent, [](const Element<Ring>& lhs, const Element<Ring>& rhs) { return lhs * rhs; });
+}
+
+template <typename Ring>
+Element<Ring>& Element<Ring>::fma(const Element<Ring>& a, const Element<Ring>& b) {
+  return *this = Implementation::sum(*this, {{a, b, false}});
+}
+
+template <typename Ring>
+int Element<Ring>::sign() const {
+  if (!*this)
+    return 0;
+
+  if (const auto sign = filter<Ring>(impl->enclosure()))
+    return *sign;
+
+  // This terminates since this element is non-zero.
+  return Refinement<Ring>(*this).decide([](const Arb& approximation) -> std::optional<int> {
+    if (arb_is_positive(approximation.arb_t()))
+      return 1;
+    if (arb_is_negative(approximation.arb_t()))
+      return -1;
+    return std::nullopt;
+  });
+}
+
+template <typename Ring>
+std::pair<size_t, size_t> Element<Ring>::filterStatistics() {
+  return {FilterStatistics<Ring>::decided.load(), FilterStatistics<Ring>::undecided.load()};
+}
+
 template <typename Ring>
 bool Element<Ring>::unit() const {
   if (!*this)
@@ -542,13 +740,13 @@ mpz_class Element<Ring>::floor() const {
   const auto integer = static_cast<std::optional<mpz_class>>(*this);
   if (integer) return *integer;
 
-  for (long prec = ARB_PRECISION_FAST;; prec *= 2) {
-    const Arb approximation = arb(prec);
+  return Refinement<Ring>(*this).decide([](const Arb& approximation) -> std::optional<mpz_class> {
     const auto [lower, upper] = static_cast<std::pair<Arf, Arf>>(approximation);
 
     if (lower.floor() == upper.floor())
       return lower.floor();
-  }
+    return std::nullopt;
+  });
 }
 
 template <typename Ring>
@@ -556,128 +754,128 @@ mpz_class Element<Ring>::ceil() const {
   const auto integer = static_cast<std::optional<mpz_class>>(*this);
   if (integer) return *integer;
 
-  for (long prec = ARB_PRECISION_FAST;; prec *= 2) {
-    const Arb approximation = arb(prec);
+  return Refinement<Ring>(*this).decide([](const Arb& approximation) -> std::optional<mpz_class> {
     const auto [lower, upper] = static_cast<std::pair<Arf, Arf>>(approximation);
 
     if (lower.ceil() == upper.ceil())
       return lower.ceil();
-  }
+    return std::nullopt;
+  });
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(const Element<Ring>& rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - rhs.impl->enclosure());
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(const mpq_class& rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(const mpq_class& rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(const mpz_class& rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(const mpz_class& rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(short rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(short rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(unsigned short rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(unsigned short rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(int rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(int rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(unsigned int rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(unsigned int rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(long rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(long rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(unsigned long rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(unsigned long rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(long long rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(long long rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(unsigned long long rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(unsigned long long rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure() - enclose(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator<(const RealNumber& rhs) const {
-  return lt(*this, rhs);
+  return lt(*this, rhs, impl->enclosure(rhs));
 }
 
 template <typename Ring>
 bool Element<Ring>::operator>(const RealNumber& rhs) const {
-  return gt(*this, rhs);
+  return gt(*this, rhs, impl->enclosure(rhs));
 }
 
 template <typename Ring>
@@ -778,12 +976,11 @@ bool Element<Ring>::operator==(const RealNumber& rhs) const {
   if (!*this)
     return !rhs;
 
-  const auto& gens = impl->parent->basis();
-  const auto it = find_if(begin(gens), end(gens), [&](const auto& other) { return *other == rhs; });
+  const auto index = impl->parent->index(rhs);
 
-  LIBEXACTREAL_CHECK_ARGUMENT(it != end(gens), "not implemented - equality of Element " << *this << " with unrelated RealNumber " << rhs);
+  LIBEXACTREAL_CHECK_ARGUMENT(index, "not implemented - equality of Element " << *this << " with unrelated RealNumber " << rhs);
 
-  const size at = it - begin(gens);
+  const size at = *index;
   for (int i = 0; i < impl->parent->rank(); i++) {
     if (impl->coefficients[i] == 0) {
       if (i == at) {
@@ -832,18 +1029,14 @@ Element<Ring>::operator double() const {
   // yet another bit, we know that any double contained in that
   // ball is closer to every point of the ball than any other
   // double.
-  long prec = DBL_MANT_DIG + 2;
-
-  while (true) {
-    Arb a = arb(prec);
-    auto bounds = static_cast<std::pair<Arf, Arf>>(a);
+  return Refinement<Ring>(*this, long{DBL_MANT_DIG + 2}).decide([](const Arb& approximation) -> std::optional<double> {
+    auto bounds = static_cast<std::pair<Arf, Arf>>(approximation);
     auto lbound = static_cast<double>(bounds.first);
     auto ubound = static_cast<double>(bounds.second);
     if (lbound == ubound)
       return lbound;
-
-    prec *= 2;
-  }
+    return std::nullopt;
+  });
 }
 
 template <typename Ring>
@@ -858,42 +1051,21 @@ Element<Ring>& Element<Ring>::promote(const shared_ptr<const Module<Ring>>& pare
   if (!*this)
     return *this = parent->zero();
 
-  const auto& their_gens = parent->basis();
-  const auto& our_gens = impl->parent->basis();
-
-  auto their_gen = begin(their_gens);
-  auto our_gen = begin(our_gens);
-
-  vector<typename Ring::ElementClass> coefficients;
+  const auto embedding = Module<Ring>::Implementation::embedding(impl->parent, parent);
 
-  while (their_gen != end(their_gens) || our_gen != end(our_gens)) {
-    if (our_gen == end(our_gens)) {
-      coefficients.push_back(typename Ring::ElementClass());
-      their_gen++;
-      continue;
-    }
-    if (their_gen == end(their_gens)) {
-      LIBEXACTREAL_ASSERT(!impl->coefficients[our_gen - begin(our_gens)], "Cannot promote " << *this << " to " << *parent << " since " << *our_gen << " is not in " << *parent);
-      our_gen++;
-      continue;
-    }
-    if (**our_gen == **their_gen) {
-      coefficients.push_back(parent->ring().coerce(impl->coefficients[our_gen - begin(our_gens)]));
-      our_gen++;
-      their_gen++;
-      continue;
-    }
-    if ((**our_gen).deglex(**their_gen)) {
-      our_gen++;
-      continue;
-    } else {
-      coefficients.push_back(typename Ring::ElementClass());
-      their_gen++;
+  vector<typename Ring::ElementClass> coefficients(parent->basis().size());
+  for (size_t i = 0; i < embedding->size(); i++) {
+    if ((*embedding)[i] == Module<Ring>::Implementation::NONE) {
+      LIBEXACTREAL_ASSERT(!impl->coefficients[i], "Cannot promote " << *this << " to " << *parent << " since " << *impl->parent->basis()[i] << " is not in " << *parent);
       continue;
     }
+    coefficients[(*embedding)[i]] = parent->ring().coerce(impl->coefficients[i]);
   }
 
-  return *this = Element<Ring>(parent, coefficients);
+  impl->parent = parent;
+  impl->coefficients = std::move(coefficients);
+
+  return *this;
 }
 
 template <typename Ring>
@@ -913,7 +1085,8 @@ Element<Ring>& Element<Ring>::simplify() {
   if (static_cast<size>(gens.size()) == impl->parent->rank())
     return *this;
 
-  const auto parent = Module<Ring>::make(gens, impl->parent->ring());
+  // The generators are a subset of the sorted generators of our parent.
+  const auto parent = Module<Ring>::Implementation::make(gens, impl->parent->ring(), false);
   return promote(parent);
 }
 
@@ -966,12 +1139,49 @@ std::ostream& operator<<(std::ostream& out, const Element<Ring>& self) {
   return out;
 }
 
+template <typename Ring>
+Element<Ring> det2(const Element<Ring>& a, const Element<Ring>& b, const Element<Ring>& c, const Element<Ring>& d) {
+  return Element<Ring>::Implementation::sum(Element<Ring>(), {{a, d, false}, {b, c, true}});
+}
+
+template <typename Ring>
+Element<Ring> linear_combination(const std::vector<Element<Ring>>& coefficients, const std::vector<Element<Ring>>& elements) {
+  LIBEXACTREAL_CHECK_ARGUMENT(coefficients.size() == elements.size(), "number of coefficients must match number of elements");
+
+  std::vector<typename Element<Ring>::Implementation::Product> products;
+  products.reserve(elements.size());
+  for (size_t i = 0; i < elements.size(); i++)
+    products.push_back({coefficients[i], elements[i], false});
+
+  return Element<Ring>::Implementation::sum(Element<Ring>(), products);
+}
+
+template <typename Ring>
+Element<Ring> sum(const std::vector<std::reference_wrapper<const Element<Ring>>>& summands) {
+  return Element<Ring>::Implementation::sum(summands);
+}
+
 }  // namespace exactreal
 
 namespace std {
 template <typename Ring>
 size_t hash<exactreal::Element<Ring>>::operator()(const exactreal::Element<Ring>& x) const noexcept {
-  return hash<double>()(static_cast<double>(x));
+  using flatsurf::hash_combine;
+
+  // Elements are equal iff they have the same non-zero coefficients for the
+  // same generators. Since the generators of all modules are sorted in the
+  // same way, it suffices to hash the non-zero terms in order.
+  size_t ret = 0;
+
+  const auto& basis = x.impl->parent->basis();
+  const auto& coefficients = x.impl->coefficients;
+  for (size_t i = 0; i < coefficients.size(); i++) {
+    if (coefficients[i] == 0)
+      continue;
+    ret = hash_combine(ret, exactreal::RealNumberBase::id(*basis[i]), coefficientHash(coefficients[i]));
+  }
+
+  return ret;
 }
 }  // namespace std
 
@@ -985,10 +1195,16 @@ namespace exactreal {
 
 template class Element<IntegerRing>;
 template std::ostream& operator<<(std::ostream&, const Element<IntegerRing>&);
+template Element<IntegerRing> det2(const Element<IntegerRing>&, const Element<IntegerRing>&, const Element<IntegerRing>&, const Element<IntegerRing>&);
+template Element<IntegerRing> linear_combination(const std::vector<Element<IntegerRing>>&, const std::vector<Element<IntegerRing>>&);
+template Element<IntegerRing> sum(const std::vector<std::reference_wrapper<const Element<IntegerRing>>>&);
 
 template class Element<RationalField>;
 template Element<RationalField>::Element(const Element<IntegerRing>&);
 template std::ostream& operator<<(std::ostream&, const Element<RationalField>&);
+template Element<RationalField> det2(const Element<RationalField>&, const Element<RationalField>&, const Element<RationalField>&, const Element<RationalField>&);
+template Element<RationalField> linear_combination(const std::vector<Element<RationalField>>&, const std::vector<Element<RationalField>>&);
+template Element<RationalField> sum(const std::vector<std::reference_wrapper<const Element<RationalField>>>&);
 
 template class Element<NumberField>;
 template Element<NumberField>::Element(const Element<IntegerRing>&);
@@ -996,6 +1212,9 @@ template Element<NumberField>::Element(const Element<RationalField>&);
 template Element<NumberField>& Element<NumberField>::operator*=(const NumberField::ElementClass&);
 template Element<NumberField>& Element<NumberField>::operator/=(const NumberField::ElementClass&);
 template std::ostream& operator<<(std::ostream&, const Element<NumberField>&);
+template Element<NumberField> det2(const Element<NumberField>&, const Element<NumberField>&, const Element<NumberField>&, const Element<NumberField>&);
+template Element<NumberField> linear_combination(const std::vector<Element<NumberField>>&, const std::vector<Element<NumberField>>&);
+template Element<NumberField> sum(const std::vector<std::reference_wrapper<const Element<NumberField>>>&);
 
 }  // namespace exactreal
 
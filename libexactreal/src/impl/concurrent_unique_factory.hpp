@@ -0,0 +1,159 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_CONCURRENT_UNIQUE_FACTORY_HPP
+#define LIBEXACTREAL_CONCURRENT_UNIQUE_FACTORY_HPP
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace exactreal {
+
+/// A cache of unique objects that can be used from many threads concurrently.
+///
+/// Like unique_factory::UniqueFactory, this hands out the same object for
+/// equal keys as long as that object is alive, i.e., it makes sure that
+/// objects that are equal are actually identical.
+///
+/// The keys are distributed over shards by their hash. Each shard has its own
+/// lock, so threads only contend when they create objects whose keys land in
+/// the same shard.
+///
+/// The (roughly) KeepAlive most recently created objects are kept alive even
+/// if nobody else holds a reference to them anymore.
+template <typename K, typename V, typename Hash = std::hash<K>, size_t KeepAlive = 0>
+class ConcurrentUniqueFactory {
+  static constexpr size_t SHARDS = 64;
+
+ public:
+  /// Return the object for key. If there is no such object, create it with
+  /// create(key) or create() which must return a pointer to a new V.
+  ///
+  /// Note that create might modify key (if it has mutable members) before
+  /// we store a copy of key in the cache.
+  template <typename Create>
+  std::shared_ptr<V> get(const K& key, Create&& create) {
+    return get(Hash{}(key), key, std::forward<Create>(create));
+  }
+
+  /// Return the object for key whose hash has already been computed as hash.
+  template <typename Create>
+  std::shared_ptr<V> get(size_t hash, const K& key, Create&& create) {
+    auto& shard = shards[index(hash)];
+
+    // Objects that we release from the keep alive buffer are only destroyed
+    // after we released the lock of the shard.
+    std::shared_ptr<V> released;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto [begin, end] = shard.values.equal_range(hash);
+    for (auto it = begin; it != end; it++) {
+      if (it->second.first == key) {
+        auto value = it->second.second.lock();
+        if (value)
+          return value;
+        shard.values.erase(it);
+        break;
+      }
+    }
+
+    std::shared_ptr<V> value;
+    if constexpr (std::is_invocable_v<Create, const K&>)
+      value = std::shared_ptr<V>(create(key));
+    else
+      value = std::shared_ptr<V>(create());
+
+    shard.insert(hash, key, value);
+    released = shard.keepAlive(value);
+
+    return value;
+  }
+
+ private:
+  static size_t index(size_t hash) {
+    // Hashes of our keys are often products of identifiers, so we mix the
+    // bits before picking a shard.
+    return (static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ull) >> 58 & (SHARDS - 1);
+  }
+
+  struct IdentityHash {
+    size_t operator()(size_t hash) const { return hash; }
+  };
+
+  struct Shard {
+    std::mutex mutex;
+
+    /// The objects in this shard indexed by the hash of their key.
+    std::unordered_multimap<size_t, std::pair<K, std::weak_ptr<V>>, IdentityHash> values;
+
+    /// The number of entries at which we drop the entries for objects that
+    /// have been destroyed.
+    size_t purge = 16;
+
+    /// A ring buffer of the most recently created objects of this shard.
+    std::vector<std::shared_ptr<V>> alive;
+    size_t next = 0;
+
+    void insert(size_t hash, const K& key, const std::shared_ptr<V>& value) {
+      if (values.size() >= purge) {
+        for (auto it = values.begin(); it != values.end();) {
+          if (it->second.second.expired())
+            it = values.erase(it);
+          else
+            it++;
+        }
+        purge = 2 * values.size() + 16;
+      }
+
+      values.emplace(hash, std::pair<K, std::weak_ptr<V>>{key, value});
+    }
+
+    /// Keep value alive and return the object that is not kept alive anymore
+    /// because of this.
+    std::shared_ptr<V> keepAlive(const std::shared_ptr<V>& value) {
+      constexpr size_t capacity = (KeepAlive + SHARDS - 1) / SHARDS;
+
+      if constexpr (capacity == 0) {
+        return nullptr;
+      } else {
+        if (alive.size() < capacity) {
+          alive.push_back(value);
+          return nullptr;
+        }
+
+        auto released = std::exchange(alive[next], value);
+        next = (next + 1) % capacity;
+        return released;
+      }
+    }
+  };
+
+  std::array<Shard, SHARDS> shards;
+};
+
+}  // namespace exactreal
+
+#endif
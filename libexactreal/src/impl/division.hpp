@@ -0,0 +1,214 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_DIVISION_HPP
+#define LIBEXACTREAL_DIVISION_HPP
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../exact-real/element.hpp"
+#include "../../exact-real/module.hpp"
+#include "../../exact-real/real_number.hpp"
+#include "util/assert.ipp"
+#include "real_number_base.hpp"
+
+namespace exactreal {
+
+/// Multivariate polynomial division of elements.
+///
+/// The generators of a module are monomials in some real numbers, so an
+/// element is a multivariate polynomial. The division is performed on a
+/// dense vector of coefficients of the remainder which starts out with the
+/// generators of the module of the operands and is extended by the monomials
+/// that show up during the division. Monomials are located with hash lookups
+/// by their unique identifiers and the leading term is kept in a heap. Terms
+/// are eliminated in place so we never create intermediate elements or
+/// modules; only the module of the quotient is created at the very end.
+template <typename Ring>
+class Division {
+  using Monomial = std::shared_ptr<const RealNumber>;
+  using Coefficient = typename Ring::ElementClass;
+
+  /// Orders monomials by deglex. Distinct rationals, which are equivalent in
+  /// deglex order, are told apart by their identifier (real numbers are
+  /// unique so this does not identify distinct monomials.)
+  struct Deglex {
+    bool operator()(const Monomial& lhs, const Monomial& rhs) const {
+      if (lhs == rhs)
+        return false;
+      if (lhs->deglex(*rhs))
+        return true;
+      if (rhs->deglex(*lhs))
+        return false;
+      return RealNumberBase::id(*lhs) < RealNumberBase::id(*rhs);
+    }
+  };
+
+  explicit Division(const Element<Ring>& dividend) : module(*dividend.module()), monomials(module.basis()), remainder(dividend.coefficients()), queued(remainder.size()), heap([this](size_t lhs, size_t rhs) { return Deglex()(monomials[lhs], monomials[rhs]); }) {
+    for (size_t i = 0; i < remainder.size(); i++)
+      if (remainder[i] != 0)
+        enqueue(i);
+  }
+
+  /// Return the position of monomial in the remainder; add it to the
+  /// remainder if it is not there yet.
+  size_t position(Monomial&& monomial) {
+    if (const auto position = module.index(*monomial))
+      return static_cast<size_t>(*position);
+
+    const auto [position, inserted] = positions.try_emplace(RealNumberBase::id(*monomial), monomials.size());
+    if (inserted) {
+      monomials.push_back(std::move(monomial));
+      remainder.emplace_back();
+      queued.push_back(false);
+    }
+    return position->second;
+  }
+
+  /// Make sure that the term at position is in the heap of terms.
+  void enqueue(size_t position) {
+    if (!queued[position]) {
+      queued[position] = true;
+      heap.push(position);
+    }
+  }
+
+  /// Return the position of the leading term of the remainder or nothing if
+  /// the remainder is zero.
+  std::optional<size_t> leading() {
+    while (!heap.empty()) {
+      const size_t position = heap.top();
+      heap.pop();
+      queued[position] = false;
+      if (remainder[position] != 0)
+        return position;
+    }
+    return std::nullopt;
+  }
+
+  const Module<Ring>& module;
+
+  /// The monomials of the remainder; the first ones are the generators of
+  /// module.
+  std::vector<Monomial> monomials;
+
+  /// The coefficients of the remainder in terms of monomials.
+  std::vector<Coefficient> remainder;
+
+  /// The position of the monomials that are not generators of module
+  /// indexed by their unique identifiers.
+  std::unordered_map<size_t, size_t> positions;
+
+  /// Whether a term is in the heap. Since we only ever subtract terms which
+  /// are smaller than the leading term, each term needs to be in the heap at
+  /// most once.
+  std::vector<bool> queued;
+
+  /// The positions of the non-zero terms of the remainder, leading term on
+  /// top. Terms that became zero are dropped lazily.
+  std::priority_queue<size_t, std::vector<size_t>, std::function<bool(size_t, size_t)>> heap;
+
+ public:
+  /// Return the quotient dividend / divisor if the multivariate polynomial
+  /// division has no remainder, otherwise return nothing.
+  ///
+  /// The operands must be elements of the same module.
+  static std::optional<Element<Ring>> divide(const Element<Ring>& dividend, const Element<Ring>& divisor) {
+    LIBEXACTREAL_ASSERT(dividend.module() == divisor.module(), "operands of division must be elements of the same module");
+    LIBEXACTREAL_ASSERT(divisor, "divisor must be non-zero");
+
+    Division division(dividend);
+
+    const auto& basis = dividend.module()->basis();
+
+    // The non-zero terms of the divisor; the last one is its leading term.
+    std::vector<std::pair<size_t, Coefficient>> divisor_terms;
+    {
+      const auto coefficients = divisor.coefficients();
+      for (size_t i = 0; i < coefficients.size(); i++)
+        if (coefficients[i] != 0)
+          divisor_terms.emplace_back(i, coefficients[i]);
+    }
+
+    const auto& h = basis[divisor_terms.back().first];
+    const auto& b = divisor_terms.back().second;
+
+    // The terms of the quotient, leading terms first.
+    std::vector<std::pair<Monomial, Coefficient>> quotient;
+
+    while (const auto leading = division.leading()) {
+      const auto& g = division.monomials[*leading];
+      const auto& a = division.remainder[*leading];
+
+      auto monomial = *g / *h;
+      if (!monomial.has_value())
+        return std::nullopt;
+
+      Coefficient coefficient = a / b;
+
+      if (coefficient * b != a) {
+        LIBEXACTREAL_ASSERT(!Ring::isField, "division of coefficients must be exact in fields");
+        return std::nullopt;
+      }
+
+      // The leading terms cancel exactly.
+      division.remainder[*leading] = 0;
+
+      for (size_t j = 0; j + 1 < divisor_terms.size(); j++) {
+        const auto& [i, coefficient_j] = divisor_terms[j];
+        const size_t term = division.position(**monomial * *basis[i]);
+        division.remainder[term] -= coefficient * coefficient_j;
+        if (division.remainder[term] != 0)
+          division.enqueue(term);
+      }
+
+      quotient.emplace_back(std::move(*monomial), std::move(coefficient));
+    }
+
+    if (quotient.empty())
+      return dividend.module()->zero();
+
+    // Module::make sorts the generators by deglex, so we sort the terms in
+    // the same way to keep the coefficients aligned with their monomials.
+    // (They come out in decreasing order, so reversing them is essentially
+    // all that needs to be done.)
+    std::reverse(begin(quotient), end(quotient));
+    std::sort(begin(quotient), end(quotient), [](const auto& lhs, const auto& rhs) { return Deglex()(lhs.first, rhs.first); });
+
+    typename Module<Ring>::Basis monomials;
+    std::vector<Coefficient> coefficients;
+    for (auto& [monomial, coefficient] : quotient) {
+      monomials.push_back(std::move(monomial));
+      coefficients.push_back(std::move(coefficient));
+    }
+
+    return Element<Ring>(Module<Ring>::make(monomials, dividend.module()->ring()), coefficients);
+  }
+};
+
+}  // namespace exactreal
+
+#endif
@@ -0,0 +1,144 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_DOUBLE_ENCLOSURE_HPP
+#define LIBEXACTREAL_DOUBLE_ENCLOSURE_HPP
+
+#include <flint/flint.h>
+
+#if __FLINT_RELEASE < 30000
+#include <arb.h>
+#else
+#include <flint/arb.h>
+#endif
+
+#include <e-antic/renfxx.h>
+#include <gmpxx.h>
+
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "../../exact-real/arb.hpp"
+#include "../../exact-real/arf.hpp"
+
+namespace exactreal {
+
+/// A real number x enclosed by a double value and an error bound, i.e., x
+/// lies in [value - error, value + error].
+///
+/// The arithmetic on enclosures bounds the rounding errors explicitly. It
+/// only assumes that each floating point operation has a relative error of
+/// at most DBL_EPSILON, so the bounds are correct in any rounding mode.
+/// Overflows lead to non-finite errors and therefore to inconclusive
+/// enclosures.
+class DoubleEnclosure {
+ public:
+  DoubleEnclosure() : DoubleEnclosure(0, 0) {}
+
+  DoubleEnclosure(double value, double error) : value(value), error(error) {}
+
+  double value;
+  double error;
+
+  /// Return an enclosure of the ball x.
+  static DoubleEnclosure enclose(const Arb& x) {
+    const double value = arf_get_d(arb_midref(x.arb_t()), ARF_RND_NEAR);
+    if (!std::isfinite(value))
+      return inconclusive();
+
+    Arb delta;
+    arb_sub_arf(delta.arb_t(), x.arb_t(), Arf(value).arf_t(), ARB_PRECISION_FAST);
+
+    Arf error;
+    arb_get_abs_ubound_arf(error.arf_t(), delta.arb_t(), ARB_PRECISION_FAST);
+
+    return {value, arf_get_d(error.arf_t(), ARF_RND_UP)};
+  }
+
+  /// Return an enclosure of the integer, rational, or number field element x.
+  template <typename T>
+  static DoubleEnclosure enclose(const T& x) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      const double value = static_cast<double>(x);
+      return {value, rounding(value)};
+    } else if constexpr (std::is_same_v<T, mpz_class>) {
+      if (mpz_sizeinbase(x.get_mpz_t(), 2) >= DBL_MAX_EXP)
+        return inconclusive();
+      const double value = x.get_d();
+      return {value, rounding(value)};
+    } else if constexpr (std::is_same_v<T, mpq_class>) {
+      if (mpz_sizeinbase(x.get_num_mpz_t(), 2) >= DBL_MAX_EXP || mpz_sizeinbase(x.get_den_mpz_t(), 2) >= DBL_MAX_EXP)
+        return inconclusive();
+      const double value = x.get_d();
+      return {value, rounding(value)};
+    } else {
+      static_assert(std::is_same_v<T, eantic::renf_elem_class>, "unsupported type of number");
+      return enclose(Arb(x, ARB_PRECISION_FAST));
+    }
+  }
+
+  /// Return an enclosure that does not decide anything.
+  static DoubleEnclosure inconclusive() {
+    return {0, std::numeric_limits<double>::infinity()};
+  }
+
+  DoubleEnclosure operator*(const DoubleEnclosure& rhs) const {
+    const double product = value * rhs.value;
+    return {product, inflate(std::abs(value) * rhs.error + error * std::abs(rhs.value) + error * rhs.error + rounding(product), 5)};
+  }
+
+  DoubleEnclosure operator+(const DoubleEnclosure& rhs) const {
+    const double sum = value + rhs.value;
+    return {sum, inflate(error + rhs.error + rounding(sum), 2)};
+  }
+
+  DoubleEnclosure operator-(const DoubleEnclosure& rhs) const {
+    return *this + DoubleEnclosure{-rhs.value, rhs.error};
+  }
+
+  /// Return the sign of the enclosed number if it is certain that it is
+  /// not zero.
+  std::optional<int> sign() const {
+    // Note that this comparison is exact and false if error is not finite
+    // or NaN.
+    if (std::abs(value) > error)
+      return value > 0 ? 1 : -1;
+    return std::nullopt;
+  }
+
+ private:
+  /// Return a bound for the rounding error that produced value.
+  static double rounding(double value) {
+    return std::abs(value) * DBL_EPSILON + std::numeric_limits<double>::denorm_min();
+  }
+
+  /// Return a bound for error, taking into account that error was computed
+  /// with that many floating point operations.
+  static double inflate(double error, int operations) {
+    return error * (1 + (operations + 1) * DBL_EPSILON) + (operations + 1) * std::numeric_limits<double>::denorm_min();
+  }
+
+};
+
+}  // namespace exactreal
+
+#endif
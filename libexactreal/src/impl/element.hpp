@@ -0,0 +1,343 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C)      2019 Vincent Delecroix
+ *        Copyright (C) 2019-2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_ELEMENT_IMPLEMENTATION_HPP
+#define LIBEXACTREAL_ELEMENT_IMPLEMENTATION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../exact-real/element.hpp"
+#include "../../exact-real/module.hpp"
+#include "../../exact-real/real_number.hpp"
+#include "util/assert.ipp"
+#include "double_enclosure.hpp"
+#include "module.hpp"
+
+namespace exactreal {
+
+template <typename Ring>
+struct Element<Ring>::Implementation {
+  Implementation() : Implementation(Module<Ring>::make({})) {}
+
+  explicit Implementation(const std::shared_ptr<const Module<Ring>>& parent)
+      : Implementation(parent, std::vector<typename Ring::ElementClass>(parent->rank())) {}
+
+  Implementation(const std::shared_ptr<const Module<Ring>>& parent, const std::vector<typename Ring::ElementClass>& coefficients)
+      : parent(parent), coefficients(coefficients) {
+    LIBEXACTREAL_ASSERT(static_cast<size>(coefficients.size()) == parent->rank(), "Number of Coefficients " << coefficients.size() << " does not match rank of module " << parent->rank());
+  }
+
+  template <typename T>
+  Implementation& operator*=(const T& rhs) {
+    for (auto& c : coefficients)
+      Ring::imul(c, rhs);
+
+    return *this;
+  }
+
+  template <typename T>
+  Implementation& operator/=(const T& rhs) {
+    for (auto& c : coefficients)
+      Ring::idiv(c, rhs);
+
+    return *this;
+  }
+
+  /// Return enclosures of the generators of module by doubles.
+  static const std::vector<DoubleEnclosure>& doubles(const Module<Ring>& module) {
+    return Module<Ring>::Implementation::doubles(module);
+  }
+
+  /// Return an enclosure of this element by doubles.
+  DoubleEnclosure enclosure() const {
+    const auto& generators = doubles(*parent);
+
+    DoubleEnclosure ret;
+    for (size_t i = 0; i < generators.size(); i++) {
+      if (coefficients[i])
+        ret = ret + DoubleEnclosure::enclose(coefficients[i]) * generators[i];
+    }
+    return ret;
+  }
+
+  /// Return an enclosure of this element minus rhs by doubles.
+  ///
+  /// Approximating rhs is not cheap, so we only do it when the enclosure of
+  /// this element could be conclusive at all, and use the cached enclosure
+  /// instead when rhs is a generator of our module.
+  DoubleEnclosure enclosure(const RealNumber& rhs) const {
+    const auto lhs = enclosure();
+    if (!std::isfinite(lhs.error))
+      return DoubleEnclosure::inconclusive();
+
+    if (const auto position = Module<Ring>::Implementation::index(*parent, rhs))
+      return lhs - doubles(*parent)[*position];
+
+    return lhs - DoubleEnclosure::enclose(rhs.arb(ARB_PRECISION_FAST));
+  }
+
+  /// A product lhs * rhs that is added to (or subtracted from if negate is
+  /// set) a sum.
+  struct Product {
+    const Element<Ring>& lhs;
+    const Element<Ring>& rhs;
+    bool negate;
+  };
+
+  /// Return summand + Σ ±lhs·rhs.
+  ///
+  /// The result is created in the span of the modules of the summand and
+  /// the products and its coefficients are written in a single pass without
+  /// creating any intermediate elements.
+  static Element<Ring> sum(const Element<Ring>& summand, const std::vector<Product>& products) {
+    // Zero terms do not contribute (and might live in a module over a
+    // trivial ring.)
+    std::vector<const Product*> terms;
+    for (const auto& product : products)
+      if (product.lhs && product.rhs)
+        terms.push_back(&product);
+
+    if (terms.empty())
+      return summand;
+
+    const auto& ring = terms[0]->lhs.module()->ring();
+
+    const bool compatible = (!summand || summand.module()->ring() == ring) && std::all_of(begin(terms), end(terms), [&](const auto* term) {
+      return term->lhs.module()->ring() == ring && term->rhs.module()->ring() == ring;
+    });
+
+    if (!compatible) {
+      // The operands are defined over different rings. Computing the
+      // compositum first is not worth the trouble here.
+      Element<Ring> ret = summand;
+      for (const auto* term : terms) {
+        if (term->negate)
+          ret -= term->lhs * term->rhs;
+        else
+          ret += term->lhs * term->rhs;
+      }
+      return ret;
+    }
+
+    std::vector<std::pair<std::shared_ptr<const Module<Ring>>, std::shared_ptr<const typename Module<Ring>::Implementation::Multiplication>>> multiplications;
+    multiplications.reserve(terms.size());
+
+    std::shared_ptr<const Module<Ring>> parent = summand ? summand.impl->parent : nullptr;
+    for (const auto* term : terms) {
+      multiplications.push_back(Module<Ring>::Implementation::multiplication(term->lhs.impl->parent, term->rhs.impl->parent));
+      const auto& product = multiplications.back().first;
+      parent = parent == nullptr ? product : Module<Ring>::span(parent, product);
+    }
+
+    std::vector<typename Ring::ElementClass> coefficients(parent->basis().size());
+
+    // Return the index of the generators of module in parent.
+    const auto embedding = [&](const std::shared_ptr<const Module<Ring>>& module) -> std::shared_ptr<const std::vector<size_t>> {
+      if (module == parent)
+        return nullptr;
+      return Module<Ring>::Implementation::embedding(module, parent);
+    };
+
+    if (summand) {
+      const auto into = embedding(summand.impl->parent);
+      for (size_t i = 0; i < summand.impl->coefficients.size(); i++)
+        coefficients[into ? (*into)[i] : i] = summand.impl->coefficients[i];
+    }
+
+    for (size_t k = 0; k < terms.size(); k++) {
+      const auto& lhs = terms[k]->lhs.impl->coefficients;
+      const auto& rhs = terms[k]->rhs.impl->coefficients;
+      const auto& [product, multiplication] = multiplications[k];
+      const auto into = embedding(product);
+
+      for (size_t i = 0; i < lhs.size(); i++) {
+        if (!lhs[i])
+          continue;
+        const size_t* slots = &multiplication->slots[i * rhs.size()];
+        for (size_t j = 0; j < rhs.size(); j++) {
+          const size_t slot = into ? (*into)[slots[j]] : slots[j];
+          if (terms[k]->negate)
+            coefficients[slot] -= lhs[i] * rhs[j];
+          else
+            coefficients[slot] += lhs[i] * rhs[j];
+        }
+      }
+    }
+
+    return Element<Ring>(parent, coefficients);
+  }
+
+  /// Return the sum of the summands.
+  ///
+  /// The basis of the result is determined with a single merge of the
+  /// (sorted) bases of all the modules involved, so, unlike repeated
+  /// addition, no intermediate modules are created.
+  static Element<Ring> sum(const std::vector<std::reference_wrapper<const Element<Ring>>>& summands) {
+    // Zero summands do not contribute (and might live in a module over a
+    // trivial ring.)
+    std::vector<const Element<Ring>*> terms;
+    for (const auto& summand : summands)
+      if (summand.get())
+        terms.push_back(&summand.get());
+
+    if (terms.empty())
+      return Element<Ring>();
+
+    const auto& ring = terms[0]->module()->ring();
+
+    const bool compatible = std::all_of(begin(terms), end(terms), [&](const auto* term) {
+      return term->module()->ring() == ring;
+    });
+
+    if (!compatible) {
+      // The summands are defined over different rings. Computing the
+      // compositum first is not worth the trouble here.
+      Element<Ring> ret;
+      for (const auto* term : terms)
+        ret += *term;
+      return ret;
+    }
+
+    // The distinct modules of the summands.
+    std::vector<const Module<Ring>*> modules;
+    std::unordered_map<const Module<Ring>*, size_t> index;
+    for (const auto* term : terms)
+      if (index.emplace(term->impl->parent.get(), modules.size()).second)
+        modules.push_back(term->impl->parent.get());
+
+    // Each module contains at most one rational generator which then comes
+    // first in its basis. When the modules contain distinct rational
+    // generators, we rewrite them as integer multiples of their gcd so that
+    // the merged basis contains only one rational generator.
+    std::shared_ptr<const RealNumber> rational;
+    std::vector<mpz_class> scales(modules.size(), 1);
+    {
+      std::vector<std::optional<mpq_class>> rationals(modules.size());
+      std::vector<std::shared_ptr<const RealNumber>> distinct;
+      for (size_t m = 0; m < modules.size(); m++) {
+        if (!modules[m]->rank())
+          continue;
+        const auto& gen = modules[m]->basis()[0];
+        rationals[m] = static_cast<std::optional<mpq_class>>(*gen);
+        if (rationals[m] && std::find(begin(distinct), end(distinct), gen) == end(distinct))
+          distinct.push_back(gen);
+      }
+
+      if (distinct.size() > 1) {
+        mpz_class num = 0, den = 1;
+        for (const auto& gen : distinct) {
+          const auto value = *static_cast<std::optional<mpq_class>>(*gen);
+          mpz_gcd(num.get_mpz_t(), num.get_mpz_t(), value.get_num_mpz_t());
+          mpz_lcm(den.get_mpz_t(), den.get_mpz_t(), value.get_den_mpz_t());
+        }
+        const mpq_class gcd(num, den);
+        rational = RealNumber::rational(gcd);
+
+        for (size_t m = 0; m < modules.size(); m++)
+          if (rationals[m])
+            scales[m] = mpq_class(*rationals[m] / gcd).get_num();
+      }
+    }
+
+    // Return the i-th generator of the m-th module after rewriting the
+    // rational generators.
+    const auto generator = [&](size_t m, size_t i) -> const std::shared_ptr<const RealNumber>& {
+      if (i == 0 && rational && scales[m] != 1)
+        return rational;
+      return modules[m]->basis()[i];
+    };
+
+    // Merge the bases of the modules which are all sorted by deglex.
+    using Cursor = std::pair<size_t, size_t>;
+    const auto after = [&](const Cursor& lhs, const Cursor& rhs) {
+      const auto& l = modules[lhs.first]->basis()[lhs.second];
+      const auto& r = modules[rhs.first]->basis()[rhs.second];
+      if (r->deglex(*l))
+        return true;
+      if (l->deglex(*r))
+        return false;
+      // Keep the merge stable so that generators that are equivalent in
+      // deglex order (distinct rationals) come out in a fixed order.
+      return lhs.first > rhs.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> queue(after);
+    for (size_t m = 0; m < modules.size(); m++)
+      if (modules[m]->rank())
+        queue.push({m, 0});
+
+    typename Module<Ring>::Basis basis;
+    // The position of the generators of each module in basis.
+    std::vector<std::vector<size_t>> embeddings(modules.size());
+    while (!queue.empty()) {
+      const auto [m, i] = queue.top();
+      queue.pop();
+
+      // Since all rationals are equivalent in deglex order and come first,
+      // the rewritten rational generators are merged here.
+      const auto& gen = generator(m, i);
+      if (basis.empty() || basis.back() != gen)
+        basis.push_back(gen);
+      embeddings[m].push_back(basis.size() - 1);
+
+      if (i + 1 < modules[m]->basis().size())
+        queue.push({m, i + 1});
+    }
+
+    std::vector<typename Ring::ElementClass> coefficients(basis.size());
+    for (const auto* term : terms) {
+      const size_t m = index.at(term->impl->parent.get());
+      const auto& into = embeddings[m];
+      for (size_t i = 0; i < into.size(); i++) {
+        if (i == 0 && scales[m] != 1)
+          coefficients[into[i]] += term->impl->coefficients[i] * scales[m];
+        else
+          coefficients[into[i]] += term->impl->coefficients[i];
+      }
+    }
+
+    // Only create a module if none of the existing ones is the span.
+    std::shared_ptr<const Module<Ring>> parent;
+    for (const auto* term : terms) {
+      if (static_cast<size_t>(term->impl->parent->rank()) == basis.size() && term->impl->parent->basis()[0] == basis[0]) {
+        parent = term->impl->parent;
+        break;
+      }
+    }
+    if (parent == nullptr)
+      parent = Module<Ring>::Implementation::make(basis, ring, true);
+
+    return Element<Ring>(parent, coefficients);
+  }
+
+  std::shared_ptr<const Module<Ring>> parent;
+  std::vector<typename Ring::ElementClass> coefficients;
+};
+
+}  // namespace exactreal
+
+#endif
@@ -0,0 +1,341 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_FMPZ_MPOLY_HPP
+#define LIBEXACTREAL_FMPZ_MPOLY_HPP
+
+#include <flint/fmpz.h>
+#include <flint/fmpz_mpoly.h>
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../exact-real/element.hpp"
+#include "../../exact-real/integer_ring.hpp"
+#include "../../exact-real/module.hpp"
+#include "../../exact-real/rational_field.hpp"
+#include "../../exact-real/real_number.hpp"
+#include "util/assert.ipp"
+#include "real_number_base.hpp"
+
+namespace exactreal {
+
+/// Arithmetic of elements with integer or rational coefficients through
+/// FLINT's multivariate polynomials.
+///
+/// The generators of a module are monomials in some transcendental real
+/// numbers, so an element is a multivariate polynomial in these reals. For
+/// elements with many terms, FLINT's heap-based (and threaded) arithmetic in
+/// ℤ[x_1, …, x_n] is much faster than our naive arithmetic on coefficient
+/// vectors.
+template <typename Ring>
+class FmpzMpoly {
+  using Coefficient = typename Ring::ElementClass;
+  using Exponents = std::vector<ulong>;
+
+ public:
+  /// Whether this backend can be used with coefficients in Ring.
+  static constexpr bool supported = std::is_same_v<Ring, IntegerRing> || std::is_same_v<Ring, RationalField>;
+
+  /// Return whether the product (or quotient) of elements with that many
+  /// non-zero terms should be computed by this backend.
+  ///
+  /// For few terms, the conversion to FLINT polynomials is more expensive
+  /// than the arithmetic itself.
+  static bool worthwhile(size_t lhs, size_t rhs) {
+    return lhs * rhs >= 256;
+  }
+
+  /// Return the coefficients of lhs * rhs in product, the module spanned by
+  /// the products of the generators of the operands' modules.
+  ///
+  /// Returns nothing if some generators are not monomials, i.e., rationals
+  /// other than 1.
+  static std::optional<std::vector<Coefficient>> multiply(const Element<Ring>& lhs, const Element<Ring>& rhs, const Module<Ring>& product) {
+    Context context;
+    if (!context.add(*lhs.module()) || !context.add(*rhs.module()) || !context.add(product) || context.empty())
+      return std::nullopt;
+
+    context.init();
+
+    const auto [a, da] = context.polynomial(lhs);
+    const auto [b, db] = context.polynomial(rhs);
+
+    Polynomial c(context);
+    fmpz_mpoly_mul(c.poly, a.poly, b.poly, context.ctx);
+
+    // Determine where each monomial lives in the product.
+    std::map<Exponents, size_t> slots;
+    const auto& basis = context.exponents(product);
+    for (size_t i = 0; i < basis.size(); i++)
+      slots[basis[i]] = i;
+
+    std::vector<Coefficient> coefficients(basis.size());
+
+    const mpz_class denominator = da * db;
+    Exponents exponents(context.size());
+    mpz_class coefficient;
+    for (slong i = 0; i < fmpz_mpoly_length(c.poly, context.ctx); i++) {
+      fmpz_mpoly_get_term_exp_ui(exponents.data(), c.poly, i, context.ctx);
+      coefficients[slots.at(exponents)] = context.coefficient(c, i, denominator);
+    }
+
+    return coefficients;
+  }
+
+  /// Return the quotient dividend / divisor if the multivariate polynomial
+  /// division has no remainder, otherwise return nothing.
+  ///
+  /// Returns an empty outer optional if some generators are not monomials,
+  /// i.e., rationals other than 1.
+  static std::optional<std::optional<Element<Ring>>> divide(const Element<Ring>& dividend, const Element<Ring>& divisor) {
+    Context context;
+    if (!context.add(*dividend.module()) || !context.add(*divisor.module()) || context.empty())
+      return std::nullopt;
+
+    context.init();
+
+    const auto [a, da] = context.polynomial(dividend);
+    auto [b, db] = context.polynomial(divisor);
+
+    // Over the rationals, we divide by the primitive part of the divisor
+    // instead; by Gauss's lemma, it divides the dividend in ℚ[x] iff it
+    // divides it in ℤ[x].
+    mpz_class content = 1;
+    if constexpr (std::is_same_v<Ring, RationalField>) {
+      fmpz_t c;
+      fmpz_init(c);
+      fmpz_mpoly_content(c, b.poly, context.ctx);
+      fmpz_mpoly_scalar_divexact_fmpz(b.poly, b.poly, c, context.ctx);
+      fmpz_get_mpz(content.get_mpz_t(), c);
+      fmpz_clear(c);
+    }
+
+    Polynomial q(context);
+    if (!fmpz_mpoly_divides(q.poly, a.poly, b.poly, context.ctx))
+      return std::optional<Element<Ring>>{};
+
+    const slong length = fmpz_mpoly_length(q.poly, context.ctx);
+    if (length == 0)
+      return std::optional<Element<Ring>>{dividend.module()->zero()};
+
+    const mpz_class denominator = da * content;
+
+    std::vector<std::pair<std::shared_ptr<const RealNumber>, Coefficient>> terms;
+    Exponents exponents(context.size());
+    for (slong i = 0; i < length; i++) {
+      fmpz_mpoly_get_term_exp_ui(exponents.data(), q.poly, i, context.ctx);
+      Coefficient coefficient = context.coefficient(q, i, denominator);
+      if constexpr (std::is_same_v<Ring, RationalField>)
+        coefficient *= db;
+      terms.emplace_back(context.monomial(exponents), std::move(coefficient));
+    }
+
+    std::sort(begin(terms), end(terms), [](const auto& lhs, const auto& rhs) { return lhs.first->deglex(*rhs.first); });
+
+    typename Module<Ring>::Basis basis;
+    std::vector<Coefficient> coefficients;
+    for (auto& [monomial, coefficient] : terms) {
+      basis.push_back(std::move(monomial));
+      coefficients.push_back(std::move(coefficient));
+    }
+
+    return std::optional<Element<Ring>>{Element<Ring>(Module<Ring>::make(basis, dividend.module()->ring()), coefficients)};
+  }
+
+ private:
+  class Context;
+
+  /// A polynomial in the variables of a context.
+  struct Polynomial {
+    explicit Polynomial(const Context& context) : context(context) {
+      fmpz_mpoly_init(poly, context.ctx);
+    }
+
+    Polynomial(const Polynomial&) = delete;
+    Polynomial(Polynomial&& rhs) : context(rhs.context) {
+      fmpz_mpoly_init(poly, context.ctx);
+      fmpz_mpoly_swap(poly, rhs.poly, context.ctx);
+    }
+
+    ~Polynomial() { fmpz_mpoly_clear(poly, context.ctx); }
+
+    const Context& context;
+    fmpz_mpoly_t poly;
+  };
+
+  /// Maps the transcendental reals that make up the generators of some
+  /// modules to the variables of a polynomial ring.
+  class Context {
+   public:
+    Context() = default;
+    Context(const Context&) = delete;
+
+    ~Context() {
+      if (initialized)
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /// Record the generators of module; returns whether they are all
+    /// monomials.
+    bool add(const Module<Ring>& module) {
+      LIBEXACTREAL_ASSERT(!initialized, "cannot add modules to an initialized context");
+
+      if (factors.find(&module) != end(factors))
+        return true;
+
+      std::vector<RealNumberBase::Factors> gens;
+      for (const auto& gen : module.basis()) {
+        auto f = RealNumberBase::factors(*gen);
+        if (!f)
+          return false;
+        for (const auto& [variable, _] : *f)
+          variables.emplace(RealNumberBase::id(*variable), variable);
+        gens.push_back(std::move(*f));
+      }
+
+      factors.emplace(&module, std::move(gens));
+      return true;
+    }
+
+    /// Return whether there are no variables.
+    bool empty() const { return variables.empty(); }
+
+    /// Return the number of variables.
+    size_t size() const { return variables.size(); }
+
+    /// Create the polynomial ring once all modules have been added.
+    void init() {
+      size_t index = 0;
+      for (const auto& [id, _] : variables)
+        indexes[id] = index++;
+
+      fmpz_mpoly_ctx_init(ctx, static_cast<slong>(variables.size()), ORD_DEGLEX);
+      initialized = true;
+    }
+
+    /// Return the exponent vectors of the generators of module.
+    const std::vector<Exponents>& exponents(const Module<Ring>& module) {
+      auto& ret = cached[&module];
+      if (ret.empty()) {
+        for (const auto& gen : factors.at(&module)) {
+          Exponents exponents(variables.size());
+          for (const auto& [variable, exponent] : gen)
+            exponents[indexes.at(RealNumberBase::id(*variable))] = static_cast<ulong>(exponent);
+          ret.push_back(std::move(exponents));
+        }
+      }
+      return ret;
+    }
+
+    /// Return the monomial with the given exponent vector.
+    std::shared_ptr<const RealNumber> monomial(const Exponents& exponents) const {
+      RealNumberBase::Factors factors;
+      size_t i = 0;
+      for (const auto& [_, variable] : variables) {
+        if (exponents[i])
+          factors.emplace_back(variable, static_cast<int>(exponents[i]));
+        i++;
+      }
+      return RealNumberBase::monomial(factors);
+    }
+
+    /// Return a polynomial p and an integer d such that element = p / d.
+    std::pair<Polynomial, mpz_class> polynomial(const Element<Ring>& element) {
+      const auto coefficients = element.coefficients();
+      const auto& gens = exponents(*element.module());
+
+      mpz_class denominator = 1;
+      if constexpr (std::is_same_v<Ring, RationalField>)
+        for (const auto& c : coefficients)
+          mpz_lcm(denominator.get_mpz_t(), denominator.get_mpz_t(), c.get_den_mpz_t());
+
+      Polynomial p(*this);
+
+      fmpz_t c;
+      fmpz_init(c);
+      for (size_t i = 0; i < coefficients.size(); i++) {
+        if (coefficients[i] == 0)
+          continue;
+
+        if constexpr (std::is_same_v<Ring, RationalField>) {
+          const mpz_class numerator = coefficients[i].get_num() * (denominator / coefficients[i].get_den());
+          fmpz_set_mpz(c, numerator.get_mpz_t());
+        } else {
+          fmpz_set_mpz(c, coefficients[i].get_mpz_t());
+        }
+
+        fmpz_mpoly_push_term_fmpz_ui(p.poly, c, gens[i].data(), ctx);
+      }
+      fmpz_clear(c);
+
+      fmpz_mpoly_sort_terms(p.poly, ctx);
+      fmpz_mpoly_combine_like_terms(p.poly, ctx);
+
+      return {std::move(p), denominator};
+    }
+
+    /// Return the ith coefficient of p divided by denominator.
+    Coefficient coefficient(const Polynomial& p, slong i, const mpz_class& denominator) const {
+      fmpz_t c;
+      fmpz_init(c);
+      fmpz_mpoly_get_term_coeff_fmpz(c, p.poly, i, ctx);
+
+      mpz_class numerator;
+      fmpz_get_mpz(numerator.get_mpz_t(), c);
+      fmpz_clear(c);
+
+      if constexpr (std::is_same_v<Ring, RationalField>) {
+        mpq_class ret(numerator, denominator);
+        ret.canonicalize();
+        return ret;
+      } else {
+        LIBEXACTREAL_ASSERT(denominator == 1, "integer polynomials cannot have a denominator");
+        return numerator;
+      }
+    }
+
+    fmpz_mpoly_ctx_t ctx;
+
+   private:
+    bool initialized = false;
+
+    /// The variables, i.e., the transcendental reals, ordered by their id.
+    std::map<size_t, std::shared_ptr<const RealNumber>> variables;
+
+    /// The index of each variable, by id.
+    std::map<size_t, size_t> indexes;
+
+    /// The factors of the generators of each module.
+    std::map<const Module<Ring>*, std::vector<RealNumberBase::Factors>> factors;
+
+    /// The exponent vectors of the generators of each module.
+    std::map<const Module<Ring>*, std::vector<Exponents>> cached;
+  };
+};
+
+}  // namespace exactreal
+
+#endif
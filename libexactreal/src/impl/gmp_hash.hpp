@@ -0,0 +1,60 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_GMP_HASH_HPP
+#define LIBEXACTREAL_GMP_HASH_HPP
+
+#include <gmpxx.h>
+
+#include <cstddef>
+
+#include "external/hash-combine/hash.hpp"
+
+namespace exactreal {
+
+/// Hashes GMP integers and rationals by their limbs.
+///
+/// Unlike a hash of the double approximation, this distinguishes numbers
+/// that are very close to each other, e.g., 1 and 1 + 2^-80.
+struct GmpHash {
+  size_t operator()(const mpz_class& x) const {
+    return (*this)(x.get_mpz_t());
+  }
+
+  size_t operator()(const mpq_class& x) const {
+    using flatsurf::hash_combine;
+    return hash_combine((*this)(x.get_num_mpz_t()), (*this)(x.get_den_mpz_t()));
+  }
+
+  size_t operator()(mpz_srcptr x) const {
+    using flatsurf::hash_combine;
+
+    const size_t size = mpz_size(x);
+
+    size_t ret = hash_combine(static_cast<size_t>(mpz_sgn(x) + 1), size);
+    for (size_t i = 0; i < size; i++)
+      ret = hash_combine(ret, static_cast<size_t>(mpz_getlimbn(x, static_cast<mp_size_t>(i))));
+
+    return ret;
+  }
+};
+
+}  // namespace exactreal
+
+#endif
@@ -0,0 +1,421 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C)      2019 Vincent Delecroix
+ *        Copyright (C) 2019-2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_MODULE_IMPLEMENTATION_HPP
+#define LIBEXACTREAL_MODULE_IMPLEMENTATION_HPP
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../exact-real/arb.hpp"
+#include "../../exact-real/arb_vector.hpp"
+#include "../../exact-real/module.hpp"
+#include "../../exact-real/real_number.hpp"
+#include "external/hash-combine/hash.hpp"
+#include "util/assert.ipp"
+#include "concurrent_unique_factory.hpp"
+#include "double_enclosure.hpp"
+#include "real_number_base.hpp"
+
+namespace exactreal {
+
+template <typename Ring>
+struct Module<Ring>::Implementation {
+  using Basis = typename Module<Ring>::Basis;
+
+  Implementation() : basis({}), parameters(trivial()) {}
+
+  explicit Implementation(const Basis& basis, const Ring& parameters) : basis(basis), parameters(parameters) {}
+
+  static Ring& trivial() {
+    static Ring trivial = {};
+    return trivial;
+  }
+
+  Basis basis;
+  Ring parameters;
+
+  class Key {
+   public:
+    Key(const Basis& basis, Ring ring) : Key([&]() {
+      std::vector<size_t> ids;
+      ids.reserve(basis.size());
+      for (const auto& real : basis)
+        ids.push_back(RealNumberBase::id(*real));
+      return ids;
+    }(), std::move(ring)) {}
+
+    /// Create the key of the module over ring whose generators have the
+    /// identifiers ids.
+    Key(std::vector<size_t> ids, Ring ring) : basis(std::move(ids)), ring(std::move(ring)), digest([&]() {
+      using flatsurf::hash, flatsurf::hash_combine;
+
+      size_t ret = hash(this->ring);
+      for (const auto& b : this->basis)
+        ret = hash_combine(ret, b);
+
+      return ret;
+    }()) {}
+
+    bool operator==(const Key& rhs) const {
+      return digest == rhs.digest && this->ring == rhs.ring && this->basis == rhs.basis;
+    }
+
+    size_t hash() const { return digest; }
+
+    struct Hash {
+      size_t operator()(const Key& key) const {
+        return key.hash();
+      }
+    };
+
+   private:
+    std::vector<size_t> basis;
+    Ring ring;
+    size_t digest;
+  };
+
+  static auto& factory() {
+    static ConcurrentUniqueFactory<Key, Module<Ring>, typename Key::Hash, 1024> factory;
+    return factory;
+  }
+
+  /// Return the module with the given generators which must be sorted by
+  /// deglex.
+  ///
+  /// If validate is not set, the generators are assumed to be distinct with
+  /// at most one of them rational, e.g., because they are the generators of
+  /// existing modules or products thereof.
+  static std::shared_ptr<const Module<Ring>> make(const Basis& basis, const Ring& ring, bool validate) {
+    return make(basis, ring, Key{basis, ring}, validate);
+  }
+
+  /// Return the module with the given generators which must be sorted by
+  /// deglex and whose key has already been computed.
+  static std::shared_ptr<const Module<Ring>> make(const Basis& basis, const Ring& ring, const Key& key, bool validate) {
+    return factory().get(key.hash(), key, [&]() {
+      // Modules that already exist have been validated when they were
+      // created, so we only need to validate new modules.
+      if (validate)
+        Implementation::validate(basis);
+
+      return new Module<Ring>(spimpl::make_unique_impl<Implementation>(basis, ring));
+    });
+  }
+
+  /// Throw an exception if the generators, sorted by deglex, are not distinct
+  /// or if more than one of them is rational.
+  static void validate(const Basis& basis) {
+    size_t rationals = 0;
+    for (const auto& gen : basis) {
+      if (static_cast<std::optional<mpq_class>>(*gen))
+        rationals++;
+    }
+
+    if (rationals > 1)
+      throw std::logic_error("at most one generator can be rational");
+
+    // Since there is at most one rational, generators that are equivalent in
+    // deglex order are identical. So duplicates must be adjacent.
+    for (size_t i = 1; i < basis.size(); i++) {
+      if (basis[i - 1] == basis[i])
+        throw std::logic_error("generators must be distinct");
+    }
+  }
+
+  /// Data about this module and other modules that is cached with this
+  /// module, indexed by the other module.
+  ///
+  /// The cache only holds weak references to the other modules so it does
+  /// not keep them alive.
+  template <typename T>
+  class Relations {
+   public:
+    /// Return the data cached for other or nothing if there is none.
+    std::shared_ptr<const T> get(std::mutex& mutex, const std::shared_ptr<const Module<Ring>>& other) const {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      const auto cached = entries.find(other.get());
+      if (cached == entries.end() || cached->second.first.lock() != other)
+        return nullptr;
+      return cached->second.second;
+    }
+
+    /// Cache value for other.
+    void set(std::mutex& mutex, const std::shared_ptr<const Module<Ring>>& other, std::shared_ptr<const T> value) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (entries.size() >= LIMIT) {
+        for (auto it = entries.begin(); it != entries.end();) {
+          if (it->second.first.expired())
+            it = entries.erase(it);
+          else
+            it++;
+        }
+        if (entries.size() >= LIMIT)
+          entries.clear();
+      }
+
+      entries[other.get()] = {other, std::move(value)};
+    }
+
+   private:
+    /// The maximum number of other modules for which we cache data.
+    static constexpr size_t LIMIT = 256;
+
+    std::unordered_map<const Module<Ring>*, std::pair<std::weak_ptr<const Module<Ring>>, std::shared_ptr<const T>>> entries;
+  };
+
+  /// The multiplication table of this module with another module over the
+  /// same ring.
+  struct Multiplication {
+    std::weak_ptr<const Module<Ring>> product;
+
+    /// The index of the generator basis[i] * rhs->basis[j] in product at
+    /// i * rhs->rank() + j.
+    std::vector<size_t> slots;
+  };
+
+  /// Return the module spanned by the products of generators of lhs and rhs
+  /// together with the table of where each product of generators ends up in
+  /// that module.
+  static std::pair<std::shared_ptr<const Module<Ring>>, std::shared_ptr<const Multiplication>> multiplication(const std::shared_ptr<const Module<Ring>>& lhs, const std::shared_ptr<const Module<Ring>>& rhs) {
+    LIBEXACTREAL_ASSERT(lhs->ring() == rhs->ring(), "cannot multiply modules over different rings");
+
+    auto& self = *lhs->impl;
+
+    if (const auto cached = self.multiplications.get(self.mutex, rhs)) {
+      if (auto product = cached->product.lock())
+        return {product, cached};
+    }
+
+    // Compute the products of generators outside of the lock. Another thread
+    // might do the same at the same time but they are going to create the
+    // same table.
+    auto multiplication = std::make_shared<Multiplication>();
+
+    const auto& lhs_basis = lhs->basis();
+    const auto& rhs_basis = rhs->basis();
+
+    // Collect the distinct products of generators in an open-addressing hash
+    // table keyed by their identifiers.
+    static constexpr size_t EMPTY = std::numeric_limits<size_t>::max();
+
+    size_t capacity = 16;
+    while (capacity < 2 * lhs_basis.size() * rhs_basis.size())
+      capacity *= 2;
+    const size_t mask = capacity - 1;
+
+    // The table is scratch space that is reused by later calls on this
+    // thread so that we do not allocate it for every new pair of modules.
+    thread_local std::vector<size_t> table;
+    table.assign(capacity, EMPTY);
+    Basis products;
+    std::vector<size_t> ids;
+
+    multiplication->slots.reserve(lhs_basis.size() * rhs_basis.size());
+
+    for (const auto& lhs_gen : lhs_basis) {
+      for (const auto& rhs_gen : rhs_basis) {
+        auto product = *lhs_gen * *rhs_gen;
+        const size_t id = RealNumberBase::id(*product);
+
+        // The identifiers are consecutive, so we mix their bits before probing.
+        size_t slot = (id * 0x9E3779B97F4A7C15ull >> 32) & mask;
+        while (table[slot] != EMPTY && products[table[slot]] != product)
+          slot = (slot + 1) & mask;
+
+        if (table[slot] == EMPTY) {
+          table[slot] = products.size();
+          products.push_back(std::move(product));
+          ids.push_back(id);
+        }
+
+        multiplication->slots.push_back(table[slot]);
+      }
+    }
+
+    // Sort the products by deglex and relabel the slots accordingly.
+    std::vector<size_t> order(products.size());
+    for (size_t i = 0; i < order.size(); i++)
+      order[i] = i;
+    std::sort(begin(order), end(order), [&](size_t i, size_t j) { return products[i]->deglex(*products[j]); });
+
+    std::vector<size_t> position(products.size());
+    Basis basis;
+    basis.reserve(products.size());
+    std::vector<size_t> sorted;
+    sorted.reserve(products.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      position[order[i]] = i;
+      basis.push_back(std::move(products[order[i]]));
+      sorted.push_back(ids[order[i]]);
+    }
+
+    for (auto& slot : multiplication->slots)
+      slot = position[slot];
+
+    auto product = make(basis, lhs->ring(), Key{std::move(sorted), lhs->ring()}, false);
+    LIBEXACTREAL_ASSERT(product->basis() == basis, "order of generators in module is not deglex which is the assumption by Element::operator/=");
+
+    multiplication->product = product;
+
+    self.multiplications.set(self.mutex, rhs, multiplication);
+
+    return {product, multiplication};
+  }
+
+  /// Marks a generator that has no counterpart in an \ref embedding.
+  static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  /// Return for each generator of module its index in the basis of target,
+  /// or NONE if it is not a generator of target.
+  static std::shared_ptr<const std::vector<size_t>> embedding(const std::shared_ptr<const Module<Ring>>& module, const std::shared_ptr<const Module<Ring>>& target) {
+    auto& self = *module->impl;
+
+    if (auto cached = self.embeddings.get(self.mutex, target))
+      return cached;
+
+    const auto& our_gens = module->basis();
+
+    auto embedding = std::make_shared<std::vector<size_t>>(our_gens.size(), NONE);
+
+    // Look up our generators in the index of target, so that embedding a
+    // small module into a large one does not walk the basis of the large
+    // module.
+    for (size_t i = 0; i < our_gens.size(); i++) {
+      if (const auto position = index(*target, *our_gens[i]))
+        (*embedding)[i] = *position;
+    }
+
+    self.embeddings.set(self.mutex, target, embedding);
+
+    return embedding;
+  }
+
+  /// Return approximations of the generators of module with prec bits of
+  /// relative accuracy.
+  ///
+  /// The approximations for the most recently used precisions are cached
+  /// with the module so that elements of the same module share them.
+  static std::shared_ptr<const ArbVector> arbs(const Module<Ring>& module, long prec) {
+    auto& self = *module.impl;
+
+    {
+      std::lock_guard<std::mutex> lock(self.mutex);
+
+      for (const auto& [precision, arbs] : self.approximations)
+        if (precision == prec)
+          return arbs;
+    }
+
+    auto arbs = std::make_shared<ArbVector>(self.basis.size());
+    for (size_t i = 0; i < self.basis.size(); i++)
+      arbs->set(i, self.basis[i]->arb(prec));
+
+    {
+      std::lock_guard<std::mutex> lock(self.mutex);
+
+      if (self.approximations.size() >= APPROXIMATIONS)
+        self.approximations.erase(self.approximations.begin());
+      self.approximations.emplace_back(prec, arbs);
+    }
+
+    return arbs;
+  }
+
+  /// Return enclosures of the generators of module by doubles.
+  ///
+  /// The enclosures are computed once when they are first needed.
+  static const std::vector<DoubleEnclosure>& doubles(const Module<Ring>& module) {
+    auto& self = *module.impl;
+
+    std::call_once(self.enclosed, [&]() {
+      const auto arbs = Implementation::arbs(module, ARB_PRECISION_FAST);
+
+      self.enclosures.reserve(self.basis.size());
+      for (size_t i = 0; i < self.basis.size(); i++)
+        self.enclosures.push_back(DoubleEnclosure::enclose((*arbs)[i]));
+    });
+
+    return self.enclosures;
+  }
+
+  /// Return the position of gen in the basis of module or nothing if gen is
+  /// not a generator of module.
+  ///
+  /// The positions of the generators are indexed by their unique identifiers
+  /// in a hash table which is built when it is first needed.
+  static std::optional<size_t> index(const Module<Ring>& module, const RealNumber& gen) {
+    auto& self = *module.impl;
+
+    std::call_once(self.indexed, [&]() {
+      self.indices.reserve(self.basis.size());
+      for (size_t i = 0; i < self.basis.size(); i++)
+        self.indices.emplace(RealNumberBase::id(*self.basis[i]), i);
+    });
+
+    const auto position = self.indices.find(RealNumberBase::id(gen));
+    if (position == self.indices.end())
+      return std::nullopt;
+    return position->second;
+  }
+
+  /// The maximum number of precisions for which we cache approximations of
+  /// the generators.
+  static constexpr size_t APPROXIMATIONS = 8;
+
+  std::mutex mutex;
+
+  /// The cached approximations of the generators, oldest first.
+  std::vector<std::pair<long, std::shared_ptr<const ArbVector>>> approximations;
+
+  std::once_flag enclosed;
+
+  /// The enclosures of the generators by doubles, see doubles().
+  std::vector<DoubleEnclosure> enclosures;
+
+  std::once_flag indexed;
+
+  /// The position of each generator in the basis indexed by the unique
+  /// identifier of the generator, see index().
+  std::unordered_map<size_t, size_t> indices;
+
+  /// The cached multiplication tables of this module indexed by the right
+  /// hand side module.
+  Relations<Multiplication> multiplications;
+
+  /// The cached spans of this module with other modules.
+  Relations<std::weak_ptr<const Module<Ring>>> spans;
+
+  /// The cached embeddings of this module into other modules.
+  Relations<std::vector<size_t>> embeddings;
+};
+
+}  // namespace exactreal
+
+#endif
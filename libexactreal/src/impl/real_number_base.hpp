@@ -21,7 +21,11 @@
 #ifndef LIBEXACTREAL_REAL_NUMBER_BASE_HPP
 #define LIBEXACTREAL_REAL_NUMBER_BASE_HPP
 
-#include <unordered_map>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "../../exact-real/arf.hpp"
@@ -32,13 +36,38 @@ namespace exactreal {
 class RealNumberBase : public RealNumber {
  public:
   RealNumberBase();
+  virtual ~RealNumberBase() override;
 
   virtual Arf arf(long prec) const final override;
   virtual Arf arf_(long prec) const = 0;
 
   static size_t id(const RealNumber&);
 
+  /// The transcendental factors of a monomial and their exponents, sorted by
+  /// \ref id.
+  using Factors = std::vector<std::pair<std::shared_ptr<const RealNumber>, int>>;
+
+  /// Return the transcendental factors of x when interpreting it as a
+  /// monomial, see \ref RealNumber::deglex. The rational 1 has no factors.
+  /// Returns nothing for other rationals since they are not monomials.
+  static std::optional<Factors> factors(const RealNumber& x);
+
+  /// Return the monomial with the given transcendental factors.
+  static std::shared_ptr<const RealNumber> monomial(const Factors& factors);
+
+ protected:
+  /// Return the approximation arf_(prec) derived from the approximation that
+  /// arf_(approximationPrec) produced for some approximationPrec > prec.
+  /// Returns nothing if this approximation cannot be derived from it.
+  ///
+  /// The default implementation rounds to the nearest float with prec + 1
+  /// bits. This has the required relative error of at most 2^-prec if the
+  /// approximation was computed with at least two more bits of precision.
+  virtual std::optional<Arf> truncate(const Arf& approximation, long approximationPrec, long prec) const;
+
  private:
+  friend struct ApproximationCache;
+
   /// Unique identifier of this real number.
   /// Real numbers are unique in the sense that a == b iff &a == &b.
   /// So, in principle, we can uniquely identify a real number though its
@@ -47,9 +76,29 @@ class RealNumberBase : public RealNumber {
   /// in caches that don't hold a strong reference to a real number.
   const size_t uniqueId;
 
-  mutable std::optional<Arf> arf54;
-  mutable std::optional<Arf> arf64;
-  mutable std::unordered_map<long, Arf> large;
+  struct Approximation {
+    long prec;
+    Arf value;
+    size_t bytes;
+  };
+
+  /// The most precise approximation that has been computed for this number,
+  /// i.e., the value of arf_(prec) for the largest prec requested so far.
+  /// This might be dropped to limit the total memory used by such cached
+  /// approximations.
+  /// The approximation itself is immutable. It is only replaced by the
+  /// approximation cache which frees the previous approximation once no
+  /// thread is reading it anymore. So a reader only needs to load this
+  /// pointer, see ApproximationCache::Reader.
+  mutable std::atomic<const Approximation*> approximation = nullptr;
+
+  /// When approximation has been used last, on the clock of the approximation
+  /// cache.
+  mutable std::atomic<size_t> lastUsed = 0;
+
+  /// The position of this number in the approximation cache if approximation
+  /// is set; protected by the mutex of the approximation cache.
+  mutable std::optional<std::list<const RealNumberBase*>::iterator> cached;
 };
 
 }  // namespace exactreal
@@ -0,0 +1,236 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBEXACTREAL_REFINEMENT_HPP
+#define LIBEXACTREAL_REFINEMENT_HPP
+
+#include <flint/flint.h>
+
+#if __FLINT_RELEASE < 30000
+#include <arb.h>
+#else
+#include <flint/arb.h>
+#endif
+
+#include <algorithm>
+#include <gmpxx.h>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "../../exact-real/arb.hpp"
+#include "../../exact-real/arb_vector.hpp"
+#include "../../exact-real/element.hpp"
+#include "../../exact-real/module.hpp"
+#include "../../exact-real/real_number.hpp"
+#include "external/gmpxxll/gmpxxll/mpz_class.hpp"
+#include "util/assert.ipp"
+
+namespace exactreal {
+
+/// Encloses a linear combination of real numbers in balls that get
+/// (eventually) arbitrarily small.
+///
+/// Each term of the linear combination is approximated with its own
+/// precision. When the enclosure is refined, only the terms whose error
+/// dominates the radius of the enclosure are approximated again. So when
+/// deciding a property of an element, such as its sign, we do not redo the
+/// work for terms that are already known well enough.
+template <typename Ring>
+class Refinement {
+ public:
+  /// Create an enclosure of element.
+  ///
+  /// The element must outlive this enclosure.
+  explicit Refinement(const Element<Ring>& element, long prec = ARB_PRECISION_FAST) {
+    add(element, false);
+    initialize(prec);
+  }
+
+  /// Return an enclosure of lhs - rhs where rhs is an element, a real
+  /// number, or a rational number.
+  ///
+  /// The operands must outlive this enclosure.
+  template <typename RHS>
+  static Refinement compare(const Element<Ring>& lhs, const RHS& rhs, long prec = ARB_PRECISION_FAST) {
+    return Refinement(lhs, rhs, prec, Difference{});
+  }
+
+  /// Return the current enclosure.
+  const Arb& arb() const { return value; }
+
+  /// Shrink the current enclosure by increasing the precision of the terms
+  /// that contribute most to its radius.
+  void refine() {
+    const size_t n = terms.size();
+
+    // The radius of each term of the linear combination.
+    std::vector<Arb> radii(n);
+
+    mag_t total;
+    mag_init(total);
+    mag_zero(total);
+
+    for (size_t i = 0; i < n; i++) {
+      arb_mul(radii[i].arb_t(), generators.arb_ptr() + i, coefficients.arb_ptr() + i, terms[i].prec);
+      mag_add(total, total, arb_radref(radii[i].arb_t()));
+    }
+
+    if (mag_is_zero(total)) {
+      // The terms are known exactly, only the summation is inexact.
+      prec *= 2;
+    } else {
+      // Refine every term that contributes at least half of the average
+      // error. These terms include the one with the biggest error and the
+      // others can at most contribute half of the total error.
+      mag_t weighted;
+      mag_init(weighted);
+      for (size_t i = 0; i < n; i++) {
+        mag_mul_ui(weighted, arb_radref(radii[i].arb_t()), 2 * n);
+        if (!mag_is_zero(arb_radref(radii[i].arb_t())) && mag_cmp(weighted, total) >= 0)
+          evaluate(i, 2 * terms[i].prec);
+      }
+      mag_clear(weighted);
+
+      // If the rounding of the summation dominates the error, sum with
+      // more precision.
+      mag_mul_ui(total, total, 2);
+      if (mag_cmp(arb_radref(value.arb_t()), total) > 0)
+        prec *= 2;
+    }
+
+    mag_clear(total);
+
+    sum();
+  }
+
+  /// Refine this enclosure until decide returns a value for it and return
+  /// that value.
+  ///
+  /// The callable decide must return an optional that holds a certified
+  /// answer for the current enclosure if possible.
+  template <typename Decide>
+  auto decide(Decide&& decide) {
+    while (true) {
+      auto decision = decide(value);
+      if (decision.has_value())
+        return *decision;
+      refine();
+    }
+  }
+
+ private:
+  /// Marks the constructor of an enclosure of a difference so that it cannot
+  /// be confused with the constructor of an enclosure of a single element.
+  struct Difference {};
+
+  template <typename RHS>
+  Refinement(const Element<Ring>& lhs, const RHS& rhs, long prec, Difference) {
+    add(lhs, false);
+
+    if constexpr (std::is_same_v<RHS, Element<Ring>>) {
+      add(rhs, true);
+    } else if constexpr (std::is_same_v<RHS, RealNumber>) {
+      terms.push_back({&rhs, std::nullopt, mpq_class(-1)});
+    } else if constexpr (std::is_same_v<RHS, long long> || std::is_same_v<RHS, unsigned long long>) {
+      terms.push_back({nullptr, std::nullopt, -mpq_class(static_cast<mpz_class>(gmpxxll::mpz_class(rhs)))});
+    } else {
+      terms.push_back({nullptr, std::nullopt, -mpq_class(rhs)});
+    }
+
+    initialize(prec);
+  }
+
+  struct Term {
+    /// The generator of this term or nullptr for the constant term.
+    const RealNumber* generator;
+    /// The coefficient of this term if it is an element of the ring.
+    std::optional<typename Ring::ElementClass> coefficient;
+    /// The coefficient of this term otherwise.
+    mpq_class rational;
+    /// The precision with which this term has been approximated.
+    long prec = 0;
+  };
+
+  void add(const Element<Ring>& element, bool negate) {
+    const auto& basis = element.module()->basis();
+    const auto coefficients = element.coefficients();
+
+    for (size_t i = 0; i < basis.size(); i++) {
+      if (!coefficients[i])
+        continue;
+      terms.push_back({basis[i].get(), negate ? typename Ring::ElementClass(-coefficients[i]) : coefficients[i], 0});
+    }
+  }
+
+  void initialize(long prec) {
+    this->prec = prec;
+
+    generators = ArbVector(terms.size());
+    coefficients = ArbVector(terms.size());
+
+    for (size_t i = 0; i < terms.size(); i++) {
+      if (terms[i].generator == nullptr)
+        generators.set(i, Arb(1));
+      evaluate(i, prec);
+    }
+
+    sum();
+  }
+
+  /// Approximate the ith term with prec bits.
+  void evaluate(size_t i, long prec) {
+    auto& term = terms[i];
+    term.prec = prec;
+
+    if (term.generator != nullptr) {
+      Arb generator = generators[i];
+      if (arb_is_zero(generator.arb_t()))
+        generator = Arb::zero_pm_inf();
+      term.generator->refine(generator, prec);
+      generators.set(i, generator);
+    }
+
+    if (term.coefficient)
+      coefficients.set(i, Ring::arb(*term.coefficient, prec));
+    else
+      coefficients.set(i, Arb(term.rational, prec));
+
+    this->prec = std::max(this->prec, prec);
+  }
+
+  /// Recompute the enclosure from the approximations of the terms.
+  void sum() {
+    value = generators.dot(coefficients, prec);
+  }
+
+  std::vector<Term> terms;
+
+  ArbVector generators;
+  ArbVector coefficients;
+
+  /// The precision used to sum up the terms.
+  long prec;
+
+  Arb value;
+};
+
+}  // namespace exactreal
+
+#endif
@@ -22,10 +22,12 @@
 
 #include <e-antic/renfxx.h>
 
+#include <algorithm>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <optional>
 #include <set>
 
 #include "../exact-real/element.hpp"
@@ -33,75 +35,9 @@
 #include "../exact-real/number_field.hpp"
 #include "../exact-real/rational_field.hpp"
 #include "../exact-real/real_number.hpp"
-#include "impl/real_number_base.hpp"
-#include "external/hash-combine/hash.hpp"
-#include "external/unique-factory/unique-factory/unique-factory.hpp"
+#include "impl/module.hpp"
 
 namespace exactreal {
-template <typename Ring>
-struct Module<Ring>::Implementation {
-  using Basis = typename Module<Ring>::Basis;
-
-  Implementation() : basis({}), parameters(trivial()) {}
-
-  explicit Implementation(const Basis& basis, const Ring& parameters) : basis(basis), parameters(parameters) {
-    for (auto it = begin(basis); it != end(basis); it++) {
-      for (auto jt = it + 1; jt != end(basis); jt++) {
-        if (static_cast<std::optional<mpq_class>>(**it) && static_cast<std::optional<mpq_class>>(**jt)) {
-          throw std::logic_error("at most one generator can be rational");
-        }
-        if (**it == **jt) {
-          throw std::logic_error("generators must be distinct");
-        }
-      }
-    }
-  }
-
-  static Ring& trivial() {
-    static Ring trivial = {};
-    return trivial;
-  }
-
-  Basis basis;
-  Ring parameters;
-
-  class Key {
-   public:
-    Key(const Basis& basis, Ring ring) : ring(std::move(ring)) {
-      this->basis.reserve(basis.size());
-      for (const auto& real : basis)
-        this->basis.push_back(RealNumberBase::id(*real));
-    }
-
-    bool operator==(const Key& rhs) const {
-      return this->ring == rhs.ring && this->basis == rhs.basis;
-    }
-
-    struct Hash {
-      size_t operator()(const Key& key) const {
-        using flatsurf::hash, flatsurf::hash_combine;
-
-        const auto& [basis, ring] = key;
-
-        size_t ret = hash(ring);
-        for (const auto& b : basis)
-          ret = hash_combine(ret, b);
-
-        return ret;
-      }
-    };
-
-   private:
-    std::vector<size_t> basis;
-    Ring ring;
-  };
-
-  static auto& factory() {
-    static unique_factory::UniqueFactory<Key, Module<Ring>, unique_factory::KeepSetAlive<Module<Ring>, 1024>, typename Key::Hash> factory;
-    return factory;
-  }
-};
-
 template <typename Ring>
 Module<Ring>::Module(spimpl::unique_impl_ptr<Module<Ring>::Implementation>&& impl) : impl(std::move(impl)) {}
 
@@ -111,12 +47,17 @@ std::shared_ptr<const Module<Ring>> Module<Ring>::make(const Basis& basis) {
 }
 
 template <typename Ring>
-std::shared_ptr<const Module<Ring>> Module<Ring>::make(const Basis& basis_, const Ring& ring) {
-  Basis basis = basis_;
-  std::sort(begin(basis), end(basis), [](const auto& lhs, const auto& rhs) { return lhs->deglex(*rhs); });
-  return Module<Ring>::Implementation::factory().get(typename Module<Ring>::Implementation::Key{basis, ring}, [&]() {
-    return new Module<Ring>(spimpl::make_unique_impl<Module<Ring>::Implementation>(basis, ring));
-  });
+std::shared_ptr<const Module<Ring>> Module<Ring>::make(const Basis& basis, const Ring& ring) {
+  const auto deglex = [](const auto& lhs, const auto& rhs) { return lhs->deglex(*rhs); };
+
+  // Bases coming out of other modules are already sorted, so we do not need
+  // to copy them.
+  if (std::is_sorted(begin(basis), end(basis), deglex))
+    return Module<Ring>::Implementation::make(basis, ring, true);
+
+  Basis sorted = basis;
+  std::sort(begin(sorted), end(sorted), deglex);
+  return Module<Ring>::Implementation::make(sorted, ring, true);
 }
 
 template <typename Ring>
@@ -150,38 +91,69 @@ std::shared_ptr<const Module<Ring>> Module<Ring>::span(const std::shared_ptr<con
     return m;
   }
 
-  if (m->impl->parameters != n->impl->parameters) {
-    auto parameters = Ring::compositum(m->impl->parameters, n->impl->parameters);
-    return span(Module<Ring>::make(m->basis(), parameters), Module<Ring>::make(n->basis(), parameters));
+  if (const auto cached = m->impl->spans.get(m->impl->mutex, n)) {
+    if (auto span = cached->lock())
+      return span;
   }
 
-  if (n->submodule(*m)) {
-    return m;
-  }
-
-  if (m->submodule(*n)) {
-    return n;
-  }
+  const auto span = [&]() {
+    if (m->impl->parameters != n->impl->parameters) {
+      auto parameters = Ring::compositum(m->impl->parameters, n->impl->parameters);
+      return Module<Ring>::span(Implementation::make(m->basis(), parameters, false), Implementation::make(n->basis(), parameters, false));
+    }
 
-  auto basis = m->basis();
-  for (auto& ngen : n->basis()) {
-    if (find_if(begin(basis), end(basis), [&](const auto& gen) { return *gen == *ngen; }) == end(basis)) {
-      basis.push_back(ngen);
+    // Merge the bases which are both sorted by deglex.
+    const auto& mgens = m->basis();
+    const auto& ngens = n->basis();
+
+    Basis basis;
+    basis.reserve(mgens.size() + ngens.size());
+
+    auto mgen = begin(mgens);
+    auto ngen = begin(ngens);
+    while (mgen != end(mgens) && ngen != end(ngens)) {
+      if (*mgen == *ngen) {
+        basis.push_back(*mgen++);
+        ngen++;
+      } else if ((*ngen)->deglex(**mgen)) {
+        basis.push_back(*ngen++);
+      } else {
+        // Note that distinct rationals are equivalent in deglex order. We
+        // keep both and let validation complain about them.
+        basis.push_back(*mgen++);
+      }
     }
-  }
+    basis.insert(end(basis), mgen, end(mgens));
+    basis.insert(end(basis), ngen, end(ngens));
+
+    if (basis.size() == mgens.size())
+      return m;
+    if (basis.size() == ngens.size())
+      return n;
 
-  return Module<Ring>::make(basis, m->impl->parameters);
+    // When both modules contain a (distinct) rational generator, the merged
+    // basis is not valid.
+    return Implementation::make(basis, m->impl->parameters, true);
+  }();
+
+  m->impl->spans.set(m->impl->mutex, n, std::make_shared<const std::weak_ptr<const Module<Ring>>>(span));
+
+  return span;
 }
 
 template <typename Ring>
 bool Module<Ring>::submodule(const Module<Ring>& supermodule) const {
-  auto super = supermodule.basis();
-  for (auto& gen : basis()) {
-    if (find_if(begin(super), end(super), [&](const auto& sgen) { return *gen == *sgen; }) == end(super)) {
-      return false;
-    }
-  }
-  return true;
+  if (rank() > supermodule.rank())
+    return false;
+
+  return std::all_of(begin(basis()), end(basis()), [&](const auto& gen) { return supermodule.index(*gen).has_value(); });
+}
+
+template <typename Ring>
+std::optional<size> Module<Ring>::index(const RealNumber& gen) const {
+  if (const auto position = Implementation::index(*this, gen))
+    return static_cast<size>(*position);
+  return std::nullopt;
 }
 
 template <typename Ring>
@@ -29,14 +29,18 @@
 
 #include <boost/random/linear_congruential.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
-#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include "../exact-real/arb.hpp"
 #include "../exact-real/arf.hpp"
 #include "../exact-real/cereal.interface.hpp"
 #include "../exact-real/real_number.hpp"
 #include "../exact-real/seed.hpp"
-#include "external/unique-factory/unique-factory/unique-factory.hpp"
+#include "impl/concurrent_unique_factory.hpp"
 #include "impl/real_number_base.hpp"
 #include "util/assert.ipp"
 
@@ -45,50 +49,166 @@ using boost::random::rand48;
 using std::optional;
 using std::ostream;
 using std::shared_ptr;
-using std::string;
-using std::stringstream;
 
 namespace {
 
-auto& factory() {
-  static unique_factory::UniqueFactory<unsigned int, RealNumber> factory;
-  return factory;
-}
+// The binary digits of a random real number in [0, 1] as produced by rand48
+// one digit at a time.
+//
+// We use a Random Number Generator that is fast and has a small memory
+// footprint. It might have some cryptographically undesirable properties but
+// this should not matter for our purposes.  Note that technically this does
+// not produce a transcendental number due to a pseudo-random number
+// generator's periodicity.
+class Rand48Digits {
+ public:
+  // The seeds that produce the same digits.
+  using Key = unsigned int;
+
+  static Key key(const Seed& seed) { return seed.value; }
+
+  Rand48Digits(const Seed& seed) : rnd(seed.value) {}
+
+  // Write the limbs of binary digits with index in [begin, end) to limbs,
+  // most significant digit first.
+  void operator()(size_t begin, size_t end, mp_limb_t* limbs) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // The generator is not reseeded when more digits are requested; it always
+    // produces the digit following the last entry of digits.
+    boost::random::uniform_int_distribution<mp_limb_t> digit(0, 1);
+    while (digits.size() < end) {
+      mp_limb_t limb = 0;
+      for (int i = 0; i < FLINT_BITS; i++)
+        limb = (limb << 1) | digit(rnd);
+      digits.push_back(limb);
+    }
+
+    std::copy(digits.begin() + static_cast<long>(begin), digits.begin() + static_cast<long>(end), limbs);
+  }
+
+ private:
+  // Protects the generator and the digits, since approximations of the same
+  // random real might be requested from several threads.
+  mutable std::mutex mutex;
+
+  mutable rand48 rnd;
+
+  // The binary digits generated so far, most significant digit first.
+  mutable std::vector<mp_limb_t> digits;
+};
+
+// The binary digits of a random real number in [0, 1] as produced by the
+// counter-based Philox-2x32-10 generator, see Salmon, Moraes, Dror, Shaw,
+// "Parallel random numbers: as easy as 1, 2, 3".
+//
+// Each evaluation produces 64 binary digits and any block of digits can be
+// computed directly without producing the preceding digits.
+//
+// The seed value is the key of the generator. The substream of the seed
+// selects the upper half of the counter, so the 2^32 blocks of each substream
+// are disjoint from the blocks of all other substreams.
+class PhiloxDigits {
+ public:
+  // The seeds that produce the same digits.
+  using Key = uint64_t;
+
+  static Key key(const Seed& seed) { return (uint64_t{seed.substream} << 32) | seed.value; }
+
+  PhiloxDigits(const Seed& seed) : seed(seed.value), substream(seed.substream) {}
+
+  // Write the limbs of binary digits with index in [begin, end) to limbs,
+  // most significant digit first.
+  void operator()(size_t begin, size_t end, mp_limb_t* limbs) const {
+    for (size_t k = begin; k < end; k++) {
+      if constexpr (FLINT_BITS == 64) {
+        *limbs++ = block(k);
+      } else {
+        const auto digits = block(k / 2);
+        *limbs++ = static_cast<mp_limb_t>(k % 2 ? digits : digits >> 32);
+      }
+    }
+  }
+
+  // Return the k-th block of 64 binary digits, most significant digit first.
+  uint64_t block(uint64_t k) const {
+    // The counter (x0, x1) is the block index k in our substream.
+    uint32_t x0 = static_cast<uint32_t>(k);
+    uint32_t x1 = static_cast<uint32_t>(k >> 32) + substream;
+    uint32_t key = seed;
+
+    for (int round = 0; round < 10; round++) {
+      const uint64_t product = uint64_t{0xD256D193} * x0;
+      x0 = static_cast<uint32_t>(product >> 32) ^ key ^ x1;
+      x1 = static_cast<uint32_t>(product);
+      key += 0x9E3779B9;
+    }
+
+    return (uint64_t{x0} << 32) | x1;
+  }
+
+ private:
+  uint32_t seed;
+  uint32_t substream;
+};
 
 // A random real number in [0, 1]
+template <typename Digits>
 class RandomRealNumber final : public RealNumberBase {
  public:
-  RandomRealNumber(unsigned int seed) : seed(seed) {}
+  RandomRealNumber(const Seed& seed) : seed(seed), digits(seed), leading([&]() {
+    // Count the leading zeros so that we can skip them when approximating.
+    mp_limb_t limb;
+    for (size_t k = 0;; k++) {
+      digits(k, k + 1, &limb);
+      if (limb != 0)
+        return k * FLINT_BITS + FLINT_BITS - FLINT_BIT_COUNT(limb);
+    }
+  }()) {}
 
-  // Creates a random Arf from digits in base 2.
-  // We could speed this up by caching numbers to some precision but let's wait
-  // with this until this shows up in the profiler…
+  // Creates a random Arf from the binary digits of this number.
   virtual Arf arf_(long prec) const override {
     if (prec < 1) {
       prec = 0;
     }
 
-    // We could work with a bigger base than 2 to speed things up here but it's
-    // probably not worth it.
-    const string chars = "01";
+    // With d binary digits, we get a relative error at most 2^(1-d). Since we
+    // want it to be at most 2^-prec, we need prec + 1 digits after the leading
+    // zeros.
+    const size_t bits = leading + static_cast<size_t>(prec) + 1;
+    const size_t limbs = (bits + FLINT_BITS - 1) / FLINT_BITS;
 
-    auto rnd = rng();
-    boost::random::uniform_int_distribution<size_t> index_dist(0, chars.size() - 1);
+    // The limbs that contain the significant digits in little endian order
+    // (the order that FLINT expects.)
+    const size_t first = leading / FLINT_BITS;
+    std::vector<mp_limb_t> mantissa(limbs - first);
+    digits(first, limbs, mantissa.data());
+    std::reverse(mantissa.begin(), mantissa.end());
 
-    long exp = 0;
-    stringstream os;
-    // With d binary digits, we get a relative error at most 2^(1-d). Since we
-    // want it to be at most 2^-prec, we need prec + 1 digits.
-    for (long digits = 0; digits < prec + 1; digits++, exp--) {
-      char c = chars[index_dist(rnd)];
-      if (digits == 0 && c == '0') {
-        digits--;
-        continue;
-      }
-      os << c;
-    }
+    fmpz_t m;
+    fmpz_init(m);
+    fmpz_set_ui_array(m, mantissa.data(), static_cast<slong>(mantissa.size()));
+
+    fmpz_t exp;
+    fmpz_init(exp);
+    fmpz_set_si(exp, -static_cast<slong>(limbs * FLINT_BITS));
 
-    return Arf(os.str(), 2, exp);
+    // Drop the digits that we generated beyond bits.
+    Arf ret;
+    arf_set_round_fmpz_2exp(ret.arf_t(), m, exp, prec + 1, ARF_RND_DOWN);
+
+    fmpz_clear(exp);
+    fmpz_clear(m);
+
+    return ret;
+  }
+
+  // Our approximations are prefixes of the binary digits of this number. So
+  // truncating a more precise approximation produces exactly arf_(prec).
+  std::optional<Arf> truncate(const Arf& approximation, long, long prec) const override {
+    Arf ret;
+    arf_set_round(ret.arf_t(), approximation.arf_t(), prec + 1, ARF_RND_DOWN);
+    return ret;
   }
 
   operator std::optional<mpq_class>() const override {
@@ -100,25 +220,33 @@ class RandomRealNumber final : public RealNumberBase {
     return *this;
   }
 
+  static std::shared_ptr<const RealNumber> make(const Seed& seed) {
+    static ConcurrentUniqueFactory<typename Digits::Key, RealNumber> factory;
+    return factory.get(Digits::key(seed), [&]() { return new RandomRealNumber(seed); });
+  }
+
   static void save(ICerealizer& archive, const std::shared_ptr<const RandomRealNumber>& self) {
-    archive.save("seed", self->seed);
+    archive.save("seed", self->seed.value);
+    if (self->seed.generator != Seed::Generator::RAND48)
+      archive.save("substream", self->seed.substream);
   }
 
-  static void load(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self) {
-    unsigned int seed;
-    archive.load("seed", seed);
-    self = factory().get(seed, [&]() { return new RandomRealNumber(seed); });
+  static void load(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self, Seed::Generator generator) {
+    unsigned int value;
+    archive.load("seed", value);
+    unsigned int substream = 0;
+    if (generator != Seed::Generator::RAND48)
+      archive.load("substream", substream);
+    self = make(Seed(value, generator, substream));
   }
 
  private:
-  unsigned int seed;
-  // We use a Random Number Generator that is fast and has a small memory
-  // footprint as we need to create it frequently. It might have some
-  // cryptographically undesirable properties but this should not matter for
-  // our purposes.  Note that technically this does not produce a
-  // transcendental number due to a pseudo-random number generator's
-  // periodicity.
-  rand48 rng() const { return rand48(seed); }
+  Seed seed;
+
+  Digits digits;
+
+  // The number of leading zero digits of this number.
+  const size_t leading;
 };
 
 }  // namespace
@@ -129,16 +257,34 @@ shared_ptr<const RealNumber> RealNumber::random() {
 }
 
 shared_ptr<const RealNumber> RealNumber::random(Seed seed) {
-  return factory().get(seed.value, [&]() { return new RandomRealNumber(seed.value); });
+  switch (seed.generator) {
+    case Seed::Generator::RAND48:
+      return RandomRealNumber<Rand48Digits>::make(seed);
+    case Seed::Generator::PHILOX:
+      return RandomRealNumber<PhiloxDigits>::make(seed);
+    default:
+      LIBEXACTREAL_UNREACHABLE("unknown random number generator");
+  }
 }
 
 void save_random(ICerealizer& archive, const std::shared_ptr<const RealNumber>& base) {
-  const auto& self = std::dynamic_pointer_cast<const RandomRealNumber>(base);
-  LIBEXACTREAL_ASSERT(self, "cannot serialize this real number as a random number");
-  RandomRealNumber::save(archive, self);
+  if (const auto& self = std::dynamic_pointer_cast<const RandomRealNumber<Rand48Digits>>(base)) {
+    RandomRealNumber<Rand48Digits>::save(archive, self);
+  } else if (const auto& self = std::dynamic_pointer_cast<const RandomRealNumber<PhiloxDigits>>(base)) {
+    RandomRealNumber<PhiloxDigits>::save(archive, self);
+  } else {
+    LIBEXACTREAL_UNREACHABLE("cannot serialize this real number as a random number");
+  }
 }
 
-void load_random(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self) {
-  RandomRealNumber::load(archive, self);
+void load_random(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self, Seed::Generator generator) {
+  switch (generator) {
+    case Seed::Generator::RAND48:
+      return RandomRealNumber<Rand48Digits>::load(archive, self, generator);
+    case Seed::Generator::PHILOX:
+      return RandomRealNumber<PhiloxDigits>::load(archive, self, generator);
+    default:
+      LIBEXACTREAL_UNREACHABLE("unknown random number generator");
+  }
 }
 }  // namespace exactreal
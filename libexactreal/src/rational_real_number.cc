@@ -23,7 +23,8 @@
 #include "../exact-real/real_number.hpp"
 #include "../exact-real/cereal.interface.hpp"
 #include "../exact-real/yap/arf.hpp"
-#include "external/unique-factory/unique-factory/unique-factory.hpp"
+#include "impl/concurrent_unique_factory.hpp"
+#include "impl/gmp_hash.hpp"
 #include "impl/real_number_base.hpp"
 #include "util/assert.ipp"
 
@@ -45,6 +46,12 @@ class RationalRealNumber final : public RealNumberBase {
     return (Arf(value.get_num(), 0) / Arf(value.get_den(), 0))(prec, Arf::Round::NEAR);
   }
 
+  // Computing arf_(prec) directly is cheap and does not depend on which
+  // approximations have been computed before.
+  std::optional<Arf> truncate(const Arf&, long, long) const override {
+    return std::nullopt;
+  }
+
   explicit operator std::optional<mpq_class>() const override {
     return value;
   }
@@ -82,10 +89,7 @@ class RationalRealNumber final : public RealNumberBase {
 
 namespace exactreal {
 shared_ptr<const RealNumber> RealNumber::rational(const mpq_class& value) {
-  struct Hash {
-    size_t operator()(const mpq_class& self) const { return std::hash<double>()(self.get_d()); }
-  };
-  static unique_factory::UniqueFactory<mpq_class, RealNumber, unique_factory::KeepNothingAlive, Hash> factory;
+  static ConcurrentUniqueFactory<mpq_class, RealNumber, GmpHash> factory;
   
   return factory.get(value, [&]() { return new RationalRealNumber(value); });
 }
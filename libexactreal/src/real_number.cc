@@ -192,32 +192,6 @@ bool RealNumber::operator==(const mpq_class& rat) const {
   return rat == static_cast<std::optional<mpq_class>>(*this);
 }
 
-Arf RealNumberBase::arf(long prec) const {
-  if (prec < 1)
-    prec = 0;
-
-  if (prec == ARF_DOUBLE_PRECISION) {
-    if (!arf54)
-      arf54 = arf_(ARF_DOUBLE_PRECISION);
-    return *arf54;
-  }
-
-  if (prec == ARB_PRECISION_FAST) {
-    if (!arf64)
-      arf64 = arf_(ARB_PRECISION_FAST);
-    return *arf64;
-  }
-
-  const long LARGE_PREC_LIMIT = 128;
-  if (large.find(prec) == end(large)) {
-    if (large.size() >= LARGE_PREC_LIMIT)
-      large.clear();
-    large[prec] = arf_(prec);
-  }
-
-  return large[prec];
-}
-
 ostream& operator<<(ostream& os, const RealNumber& self) {
   self >> os;
   return os;
@@ -236,6 +210,7 @@ const std::type_info& typeid_shared(const std::shared_ptr<T>& ptr) {
 const static Seed noSeed = Seed(0);
 const static std::type_info& RATIONAL = typeid_shared(RealNumber::rational(0));
 const static std::type_info& RANDOM = typeid_shared(RealNumber::random(noSeed));
+const static std::type_info& RANDOM_PHILOX = typeid_shared(RealNumber::random(Seed(0, Seed::Generator::PHILOX)));
 const static std::type_info& CONSTRAINED = typeid_shared(RealNumber::random(Arf(1), Arf(2), noSeed));
 const static std::type_info& PRODUCT = typeid_shared((*RealNumber::random(noSeed)) * (*RealNumber::random(noSeed)));
 
@@ -251,6 +226,9 @@ void RealNumber::save(ICerealizer& archive, const std::shared_ptr<const RealNumb
   } else if (typeid_shared(self) == RANDOM) {
     archive.save("kind", "random");
     save_random(archive, self);
+  } else if (typeid_shared(self) == RANDOM_PHILOX) {
+    archive.save("kind", "random-philox");
+    save_random(archive, self);
   } else if (typeid_shared(self) == CONSTRAINED) {
     archive.save("kind", "constrained");
     save_constrained(archive, self);
@@ -263,7 +241,7 @@ void RealNumber::save(ICerealizer& archive, const std::shared_ptr<const RealNumb
 }
 
 void load_rational(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self);
-void load_random(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self);
+void load_random(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self, Seed::Generator generator);
 void load_constrained(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self);
 void load_product(IDecerealizer& archive, std::shared_ptr<const RealNumber>& self);
 
@@ -273,7 +251,9 @@ void RealNumber::load(IDecerealizer& archive, std::shared_ptr<const RealNumber>&
   if (kind == "rational") {
     load_rational(archive, self);
   } else if (kind == "random") {
-    load_random(archive, self);
+    load_random(archive, self, Seed::Generator::RAND48);
+  } else if (kind == "random-philox") {
+    load_random(archive, self, Seed::Generator::PHILOX);
   } else if (kind == "constrained") {
     load_constrained(archive, self);
   } else if (kind == "product") {
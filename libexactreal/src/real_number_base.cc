@@ -17,7 +17,15 @@
  *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
  *********************************************************************/
 
+#include <flint/flint.h>
+
+#include <algorithm>
 #include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "impl/real_number_base.hpp"
 
@@ -25,8 +33,333 @@ namespace exactreal {
 
 static std::atomic<size_t> next = 2147483659;
 
+// The approximations cached by all real numbers.
+//
+// Looking up a cached approximation does not take any lock and does not write
+// to memory that is shared with other threads, so that approximations can be
+// read from many threads concurrently. All other operations are serialized by
+// the mutex of the cache. When the cache exceeds its memory limit, the
+// approximations that have not been used for the longest time are dropped.
+//
+// Approximations that have been replaced or dropped are retired and only
+// freed once no thread is reading them anymore. Each thread announces the
+// approximation it is reading in its own hazard pointer for this.
+struct ApproximationCache {
+  using Approximation = RealNumberBase::Approximation;
+
+  /// Maximum number of bytes used by the cached approximation of a single real
+  /// number.
+  size_t perReal = 1 << 20;
+
+  /// Maximum number of bytes used by all cached approximations together.
+  size_t total = 1 << 26;
+
+  /// Number of bytes currently used by all cached approximations.
+  size_t used = 0;
+
+  /// The real numbers that cache an approximation.
+  std::list<const RealNumberBase*> cached;
+
+  /// A logical clock that advances whenever an approximation is inserted.
+  /// Approximations remember when they have been used last on this clock.
+  std::atomic<size_t> clock = 0;
+
+  /// Approximations that are not cached anymore but might still be read by
+  /// another thread.
+  std::vector<const Approximation*> retired;
+
+  /// Protects everything but clock and hazards.
+  std::mutex mutex;
+
+  /// The approximation a thread is currently reading.
+  ///
+  /// Each hazard pointer lives on its own cache line so that threads do not
+  /// write to the same cache lines when reading approximations.
+  struct alignas(64) Hazard {
+    std::atomic<const Approximation*> pointer = nullptr;
+
+    /// Whether this hazard pointer is owned by a thread.
+    std::atomic<bool> owned = true;
+
+    Hazard* next = nullptr;
+  };
+
+  /// The hazard pointers of all threads. Hazard pointers are reused when
+  /// their thread terminates but never freed.
+  std::atomic<Hazard*> hazards = nullptr;
+
+  static ApproximationCache& instance() {
+    // We never free the cache since real numbers might be destroyed during
+    // static destruction.
+    static auto* cache = new ApproximationCache();
+    return *cache;
+  }
+
+  /// Return the hazard pointer of the current thread.
+  Hazard& hazard() {
+    struct Owner {
+      Hazard* hazard = nullptr;
+
+      ~Owner() {
+        if (hazard == nullptr)
+          return;
+        hazard->pointer.store(nullptr, std::memory_order_release);
+        hazard->owned.store(false, std::memory_order_release);
+      }
+    };
+
+    thread_local Owner owner;
+
+    if (owner.hazard == nullptr) {
+      for (auto* hazard = hazards.load(std::memory_order_acquire); hazard != nullptr; hazard = hazard->next) {
+        bool owned = false;
+        if (!hazard->owned.load(std::memory_order_relaxed) && hazard->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+          owner.hazard = hazard;
+          break;
+        }
+      }
+
+      if (owner.hazard == nullptr) {
+        auto* hazard = new Hazard();
+        hazard->next = hazards.load(std::memory_order_relaxed);
+        while (!hazards.compare_exchange_weak(hazard->next, hazard, std::memory_order_release, std::memory_order_relaxed)) {}
+        owner.hazard = hazard;
+      }
+    }
+
+    return *owner.hazard;
+  }
+
+  /// Gives access to the approximation cached for a real number and marks it
+  /// as used.
+  ///
+  /// The approximation is not freed while the reader exists. A thread can
+  /// only have one reader at a time.
+  class Reader {
+   public:
+    explicit Reader(const RealNumberBase& x) : hazard(instance().hazard()) {
+      approximation = x.approximation.load(std::memory_order_acquire);
+
+      if (approximation == nullptr)
+        return;
+
+      // The approximation might have been retired before we announced that
+      // we are reading it. Since it is not freed once we announced it, it is
+      // safe to read when it is still the cached approximation afterwards.
+      while (true) {
+        hazard.pointer.store(approximation, std::memory_order_seq_cst);
+        const auto* current = x.approximation.load(std::memory_order_seq_cst);
+        if (current == approximation)
+          break;
+        approximation = current;
+        if (approximation == nullptr)
+          return;
+      }
+
+      // We only write if the clock advanced, so that concurrent readers of
+      // the same approximation do not need to synchronize.
+      const size_t now = instance().clock.load(std::memory_order_relaxed);
+      if (x.lastUsed.load(std::memory_order_relaxed) != now)
+        x.lastUsed.store(now, std::memory_order_relaxed);
+    }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    ~Reader() { hazard.pointer.store(nullptr, std::memory_order_release); }
+
+    explicit operator bool() const { return approximation != nullptr; }
+
+    const Approximation* operator->() const { return approximation; }
+
+   private:
+    Hazard& hazard;
+    const Approximation* approximation;
+  };
+
+  /// Return the (approximate) number of bytes used to store x.
+  static size_t bytes(const Arf& x) {
+    return sizeof(Arf) + static_cast<size_t>((arf_bits(x.arf_t()) + FLINT_BITS - 1) / FLINT_BITS) * sizeof(mp_limb_t);
+  }
+
+  /// Replace the approximation of x with value = arf_(prec) if it is more
+  /// precise and the memory limits permit it.
+  void insert(const RealNumberBase& x, long prec, const Arf& value) {
+    const size_t bytes = ApproximationCache::bytes(value);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (bytes > perReal)
+      return;
+
+    // Only this method replaces approximations and we hold the mutex, so the
+    // approximation cannot change underneath us.
+    const auto* previous = x.approximation.load(std::memory_order_relaxed);
+
+    // Another thread might have inserted a more precise approximation in the
+    // meantime.
+    if (previous && previous->prec >= prec)
+      return;
+
+    x.approximation.store(new Approximation{prec, value, bytes}, std::memory_order_seq_cst);
+
+    if (previous) {
+      used -= previous->bytes;
+      retired.push_back(previous);
+    }
+    used += bytes;
+
+    if (!x.cached)
+      x.cached = cached.insert(cached.end(), &x);
+
+    x.lastUsed.store(++clock, std::memory_order_relaxed);
+
+    shrink();
+    reclaim();
+  }
+
+  /// Drop the cached approximation of x.
+  /// The mutex must be held when calling this method.
+  void erase(const RealNumberBase& x) {
+    if (!x.cached)
+      return;
+
+    const auto* approximation = x.approximation.exchange(nullptr, std::memory_order_seq_cst);
+
+    used -= approximation->bytes;
+    retired.push_back(approximation);
+
+    cached.erase(*x.cached);
+    x.cached.reset();
+  }
+
+  /// Free the retired approximations that no thread is reading anymore.
+  /// The mutex must be held when calling this method.
+  void reclaim() {
+    if (retired.empty())
+      return;
+
+    std::vector<const Approximation*> reading;
+    for (auto* hazard = hazards.load(std::memory_order_acquire); hazard != nullptr; hazard = hazard->next) {
+      if (const auto* approximation = hazard->pointer.load(std::memory_order_seq_cst))
+        reading.push_back(approximation);
+    }
+
+    std::sort(reading.begin(), reading.end());
+
+    const auto freed = std::partition(retired.begin(), retired.end(), [&](const Approximation* approximation) {
+      return std::binary_search(reading.begin(), reading.end(), approximation);
+    });
+
+    for (auto it = freed; it != retired.end(); it++)
+      delete *it;
+
+    retired.erase(freed, retired.end());
+  }
+
+  /// Drop the least recently used approximations until we are within our
+  /// memory limits.
+  /// The mutex must be held when calling this method.
+  void shrink() {
+    if (used <= total)
+      return;
+
+    // Determining the least recently used approximations is expensive, so we
+    // drop approximations until we are at 3/4 of the limit.
+    std::vector<std::pair<size_t, const RealNumberBase*>> candidates;
+    for (const auto* x : cached)
+      candidates.emplace_back(x->lastUsed.load(std::memory_order_relaxed), x);
+
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& candidate : candidates) {
+      if (used <= total / 4 * 3)
+        break;
+      erase(*candidate.second);
+    }
+  }
+
+  void limit(size_t perReal, size_t total) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    this->perReal = perReal;
+    this->total = total;
+
+    for (auto it = cached.begin(); it != cached.end();) {
+      const auto& x = **it++;
+
+      if (x.approximation.load(std::memory_order_relaxed)->bytes > perReal)
+        erase(x);
+    }
+
+    shrink();
+    reclaim();
+  }
+
+  /// Forget about x which is being destroyed.
+  void destroy(const RealNumberBase& x) {
+    std::lock_guard<std::mutex> lock(mutex);
+    erase(x);
+    reclaim();
+  }
+};
+
 RealNumberBase::RealNumberBase() : uniqueId(next++) {}
 
+RealNumberBase::~RealNumberBase() {
+  ApproximationCache::instance().destroy(*this);
+}
+
 size_t RealNumberBase::id(const RealNumber& self) { return static_cast<const RealNumberBase&>(self).uniqueId; }
 
+Arf RealNumberBase::arf(long prec) const {
+  if (prec < 1)
+    prec = 0;
+
+  // Whether a more precise approximation is cached.
+  bool precise = false;
+
+  {
+    const ApproximationCache::Reader approximation(*this);
+
+    if (approximation) {
+      if (approximation->prec == prec)
+        return approximation->value;
+
+      if (approximation->prec > prec) {
+        if (auto truncated = truncate(approximation->value, approximation->prec, prec))
+          return *truncated;
+
+        // We cannot derive this approximation but we also do not want to
+        // replace the more precise approximation in the cache.
+        precise = true;
+      }
+    }
+  }
+
+  if (precise)
+    return arf_(prec);
+
+  Arf value = arf_(prec);
+  ApproximationCache::instance().insert(*this, prec, value);
+  return value;
 }
+
+std::optional<Arf> RealNumberBase::truncate(const Arf& approximation, long approximationPrec, long prec) const {
+  // Rounding to prec + 1 bits introduces a relative error of at most
+  // 2^-(prec + 1)(1 + 2^-approximationPrec). Together with the relative error
+  // of at most 2^-approximationPrec of the approximation, this is below
+  // 2^-prec if approximationPrec >= prec + 2.
+  if (approximationPrec < prec + 2)
+    return std::nullopt;
+
+  Arf ret;
+  arf_set_round(ret.arf_t(), approximation.arf_t(), prec + 1, ARF_RND_NEAR);
+  return ret;
+}
+
+void RealNumber::approximationCacheLimits(size_t perReal, size_t total) {
+  ApproximationCache::instance().limit(perReal, total);
+}
+
+}  // namespace exactreal
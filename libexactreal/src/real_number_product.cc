@@ -28,7 +28,7 @@
 #include "../exact-real/real_number.hpp"
 #include "../exact-real/cereal.interface.hpp"
 #include "../exact-real/yap/arf.hpp"
-#include "external/unique-factory/unique-factory/unique-factory.hpp"
+#include "impl/concurrent_unique_factory.hpp"
 #include "impl/real_number_base.hpp"
 #include "util/assert.ipp"
 
@@ -406,7 +406,7 @@ class Key {
 
 /// Return a factory that turns a map {real: exponent} into the product π real^exponent.
 auto& factory() {
-  static unique_factory::UniqueFactory<Key, RealNumber, unique_factory::KeepSetAlive<RealNumber, 1024>, Key::Hash> factory;
+  static ConcurrentUniqueFactory<Key, RealNumber, Key::Hash, 1024> factory;
 
   return factory;
 }
@@ -591,6 +591,43 @@ void RealNumberProduct::load(IDecerealizer& archive, std::shared_ptr<const RealN
 }
 }  // namespace
 
+std::optional<RealNumberBase::Factors> RealNumberBase::factors(const RealNumber& x) {
+  if (typeid(x) == typeid(const RealNumberProduct&)) {
+    const auto& product = static_cast<const RealNumberProduct&>(x);
+
+    Factors factors;
+    for (size_t i = 0; i < product.monomials.size(); i++)
+      factors.emplace_back(product.monomials[i], product.exponents[i]);
+    return factors;
+  }
+
+  if (const auto rational = static_cast<std::optional<mpq_class>>(x)) {
+    if (*rational == 1)
+      return Factors{};
+    return std::nullopt;
+  }
+
+  return Factors{{x.shared_from_this(), 1}};
+}
+
+std::shared_ptr<const RealNumber> RealNumberBase::monomial(const Factors& factors) {
+  if (factors.size() == 0)
+    return RealNumber::rational(1);
+
+  if (factors.size() == 1 && factors[0].second == 1)
+    return factors[0].first;
+
+  RealNumberProduct::Monomials monomials;
+  RealNumberProduct::Exponents exponents;
+  for (const auto& [monomial, exponent] : factors) {
+    LIBEXACTREAL_ASSERT(exponent > 0, "exponents of a monomial must be positive");
+    monomials.push_back(monomial);
+    exponents.push_back(exponent);
+  }
+
+  return factory().get({monomials, exponents}, [&]() { return new RealNumberProduct(monomials, exponents); });
+}
+
 std::shared_ptr<const RealNumber> RealNumber::operator*(const RealNumber& rhs) const {
   if (static_cast<std::optional<mpq_class>>(rhs))
     // Call RationalRealNumber::operator* instead.
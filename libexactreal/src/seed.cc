@@ -20,10 +20,33 @@
 
 #include "../exact-real/seed.hpp"
 
+#include <atomic>
+#include <limits>
+
+#include "util/assert.ipp"
+
 namespace exactreal {
-static unsigned int nextSeed = 1337;
+static std::atomic<unsigned int> nextSeed = 1337;
 
 Seed::Seed() : Seed(nextSeed++) {}
 
-Seed::Seed(unsigned int seed) : value(seed) {}
+Seed::Seed(unsigned int seed) : Seed(seed, Generator::RAND48) {}
+
+Seed::Seed(unsigned int seed, Generator generator) : Seed(seed, generator, 0) {}
+
+Seed::Seed(unsigned int seed, Generator generator, unsigned int substream) : value(seed), generator(generator), substream(substream) {
+  LIBEXACTREAL_CHECK_ARGUMENT(substream == 0 || generator == Generator::PHILOX, "only the Philox generator supports substreams");
+}
+
+Seed::Stream Seed::stream(unsigned int index) {
+  LIBEXACTREAL_CHECK_ARGUMENT(index < std::numeric_limits<unsigned int>::max(), "stream index out of range");
+  return Stream(index);
+}
+
+Seed::Stream::Stream(unsigned int index) : index(index), next(0) {}
+
+Seed Seed::Stream::operator()() {
+  return Seed(next++, Generator::PHILOX, index + 1);
+}
+
 }  // namespace exactreal
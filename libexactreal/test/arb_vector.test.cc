@@ -0,0 +1,80 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <boost/lexical_cast.hpp>
+#include <utility>
+
+#include "../exact-real/arb.hpp"
+#include "../exact-real/arb_vector.hpp"
+#include "../exact-real/yap/arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+using boost::lexical_cast;
+
+namespace exactreal::test {
+
+TEST_CASE("Create/Destroy ArbVector", "[arb_vector]") {
+  delete new ArbVector();
+  delete new ArbVector(1024);
+}
+
+TEST_CASE("Copy and Move ArbVector", "[arb_vector]") {
+  ArbVector v(2);
+  v.set(0, Arb(1));
+  v.set(1, Arb(2));
+
+  ArbVector w = v;
+  w.set(0, Arb(3));
+  REQUIRE(*(v[0] == Arb(1)));
+  REQUIRE(*(w[0] == Arb(3)));
+
+  ArbVector x = std::move(w);
+  REQUIRE(x.size() == 2);
+  REQUIRE(*(x[1] == Arb(2)));
+
+  x = v;
+  REQUIRE(*(x[0] == Arb(1)));
+
+  REQUIRE(lexical_cast<std::string>(v) == "[1.00000, 2.00000]");
+  REQUIRE_THROWS(v[2]);
+}
+
+TEST_CASE("Dot Product of ArbVector", "[arb_vector]") {
+  const size_t n = 16;
+
+  ArbVector v(n), w(n);
+  Arb naive;
+  for (size_t i = 0; i < n; i++) {
+    const Arb third(mpq_class(1, 3 + static_cast<int>(i)), 64);
+    v.set(i, third);
+    w.set(i, Arb(static_cast<int>(i)));
+    naive += (third * Arb(static_cast<int>(i)))(64);
+  }
+
+  const Arb dot = v.dot(w, 64);
+
+  // The dot product must be consistent with the naive sum and lose hardly
+  // any of the accuracy of the inputs.
+  REQUIRE(arb_overlaps(dot.arb_t(), naive.arb_t()));
+  REQUIRE(arb_rel_accuracy_bits(dot.arb_t()) >= 56);
+
+  REQUIRE_THROWS(v.dot(ArbVector(n + 1), 64));
+}
+
+}  // namespace exactreal::test
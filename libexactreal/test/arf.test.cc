@@ -19,6 +19,7 @@
  *********************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <functional>
 
 #include "../exact-real/arf.hpp"
 #include "external/catch2/single_include/catch2/catch.hpp"
@@ -78,4 +79,14 @@ TEST_CASE("Swap Elements", "[arf][swap]") {
   REQUIRE(y == 0);
 }
 
+TEST_CASE("Hashing of Arf", "[arf][hash]") {
+  const auto hash = std::hash<Arf>();
+
+  REQUIRE(hash(Arf(1)) == hash(Arf(1.)));
+  REQUIRE(hash(Arf(-1)) != hash(Arf(1)));
+  REQUIRE(hash(Arf(0)) != hash(Arf(1)));
+  REQUIRE(hash(Arf("1", 10, 0)) == hash(Arf("4", 10, -2)));
+  REQUIRE(hash(Arf(1)) != hash(Arf("1180591620717411303425", 10, -70)));
+}
+
 }  // namespace exactreal::test
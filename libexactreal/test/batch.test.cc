@@ -0,0 +1,104 @@
+/**********************************************************************
+ *  This file is part of exact-real.
+ *
+ *        Copyright (C) 2024 Julian Rüth
+ *
+ *  exact-real is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  exact-real is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <e-antic/renfxx.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../exact-real/batch.hpp"
+#include "../exact-real/element.hpp"
+#include "../exact-real/integer_ring.hpp"
+#include "../exact-real/module.hpp"
+#include "../exact-real/number_field.hpp"
+#include "../exact-real/rational_field.hpp"
+#include "../exact-real/real_number.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+#include "module_generator.hpp"
+#include "element_generator.hpp"
+
+namespace exactreal::test {
+
+TEMPLATE_TEST_CASE("Batch Operations on Elements", "[batch]", IntegerRing, RationalField, NumberField) {
+  using R = TestType;
+
+  const auto& M = GENERATE(take(4, modules<R>()));
+
+  CAPTURE(M);
+
+  // Collect some elements of M and some elements of other modules.
+  std::vector<Element<R>> elements;
+
+  ElementGenerator<R> generator(M);
+  do {
+    elements.push_back(generator.get());
+  } while (elements.size() < 64 && generator.next());
+
+  elements.push_back(Element<R>());
+  elements.push_back(Module<R>::make({RealNumber::random()})->gen(0));
+  elements.push_back(-Module<R>::make({RealNumber::rational(1)})->gen(0));
+
+  SECTION("Signs") {
+    const auto signs = batch::sign(elements);
+
+    REQUIRE(signs.size() == elements.size());
+
+    for (size_t i = 0; i < elements.size(); i++) {
+      CAPTURE(elements[i]);
+      REQUIRE(signs[i] == elements[i].sign());
+    }
+
+    // Signs of a part of the elements.
+    const auto half = batch::sign(elements.data() + elements.size() / 2, elements.size() - elements.size() / 2);
+    REQUIRE(std::equal(begin(half), end(half), begin(signs) + elements.size() / 2, end(signs)));
+  }
+
+  SECTION("Orientations") {
+    auto a = elements;
+    auto b = elements;
+    auto c = elements;
+    auto d = elements;
+
+    std::rotate(begin(b), begin(b) + 1, end(b));
+    std::rotate(begin(c), begin(c) + 2, end(c));
+    std::reverse(begin(d), end(d));
+
+    const auto signs = batch::orient2d(a, b, c, d);
+
+    REQUIRE(signs.size() == elements.size());
+
+    for (size_t i = 0; i < elements.size(); i++) {
+      CAPTURE(a[i], b[i], c[i], d[i]);
+      REQUIRE(signs[i] == (a[i] * d[i] - b[i] * c[i]).sign());
+    }
+
+    REQUIRE(batch::orient2d(a.data(), b.data(), c.data(), d.data(), a.size()) == signs);
+
+    // Degenerate determinants are decided exactly.
+    for (const auto sign : batch::orient2d(a, a, a, a))
+      REQUIRE(sign == 0);
+  }
+
+  SECTION("Mismatching Sizes") {
+    REQUIRE_THROWS(batch::orient2d(elements, elements, elements, std::vector<Element<R>>{}));
+  }
+}
+
+}  // namespace exactreal::test
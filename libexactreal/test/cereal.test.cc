@@ -26,6 +26,7 @@
 
 #include "../exact-real/cereal.hpp"
 #include "../exact-real/real_number.hpp"
+#include "../exact-real/seed.hpp"
 #include "arb.hpp"
 #include "arf.hpp"
 #include "external/catch2/single_include/catch2/catch.hpp"
@@ -120,6 +121,11 @@ TEST_CASE("Serialization of RealNumber", "[cereal][real_number]") {
   test_serialization((*y) * (*y));
   test_serialization(RealNumber::rational(mpq_class(13, 37)));
   test_serialization(RealNumber::random(13.37));
+
+  const auto z = RealNumber::random(Seed(1337, Seed::Generator::PHILOX));
+  test_serialization(z);
+  test_serialization((*x) * (*z));
+  test_serialization(RealNumber::random(Seed::stream(3)()));
 }
 
 TEMPLATE_TEST_CASE("Serialization of Module", "[cereal][module]", (IntegerRing), (RationalField), (NumberField)) {
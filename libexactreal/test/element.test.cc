@@ -21,6 +21,8 @@
 #include <e-antic/renfxx.h>
 
 #include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <limits>
 #include <unordered_set>
 
 #include "../exact-real/arb.hpp"
@@ -179,6 +181,50 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
         REQUIRE((x < g || x > g));
       }
     }
+
+    // A real number which is not a generator of M.
+    const auto g = RealNumber::random();
+    REQUIRE((x < *g) != (x > *g));
+    REQUIRE((x < *g) == (x < Element(Module<R>::make({g}, M.ring()), {1})));
+  }
+
+  SECTION("Relational Operators With Nearly Equal Elements") {
+    if (M.rank() >= 2) {
+      const mpz_class x = mpz_class(1) << 256;
+      const auto a = x * M.gen(0) + M.gen(1);
+      const auto b = x * M.gen(0);
+
+      CAPTURE(a, b);
+
+      REQUIRE((a > b) == (M.gen(1) > 0));
+      REQUIRE((a < b) == (M.gen(1) < 0));
+
+      if (M.gen(0) > 0 && M.gen(1) > 0) {
+        REQUIRE(a.floordiv(b) == 1);
+        REQUIRE(b.floordiv(a) == 0);
+      }
+    }
+  }
+
+  SECTION("Sign") {
+    const auto x = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x);
+
+    const auto [decided, undecided] = Element<R>::filterStatistics();
+
+    if (!x)
+      REQUIRE(x.sign() == 0);
+    else if (x > 0)
+      REQUIRE(x.sign() == 1);
+    else
+      REQUIRE(x.sign() == -1);
+
+    REQUIRE((-x).sign() == -x.sign());
+
+    const auto [decidedAfter, undecidedAfter] = Element<R>::filterStatistics();
+    if (x)
+      REQUIRE(decidedAfter + undecidedAfter > decided + undecided);
   }
 
   SECTION("Coefficients") {
@@ -418,6 +464,8 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
     CAPTURE(x, y);
 
     REQUIRE(x * y == y * x);
+    REQUIRE((x + y) * (x - y) == x * x - y * y);
+    REQUIRE((x * y) * (x + y) == x * (y * (x + y)));
 
     if (M.rank()) {
       REQUIRE(M.one() * x == x);
@@ -431,6 +479,102 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
     REQUIRE(trivial * x == trivial);
   }
 
+  SECTION("Fused Arithmetic") {
+    const auto x = GENERATE_REF(elements<R>(M));
+    const auto y = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x, y);
+
+    REQUIRE(Element(x).fma(x, y) == x + x * y);
+    REQUIRE(Element(x).fma(y, y) == x + y * y);
+    REQUIRE(det2(x, y, y, x) == x * x - y * y);
+    REQUIRE(linear_combination<R>({x, y}, {y, x}) == x * y + y * x);
+    REQUIRE(linear_combination<R>({}, {}) == 0);
+    REQUIRE_THROWS(linear_combination<R>({x}, {}));
+
+    // Operands from different modules.
+    const auto N = Module<R>::make({RealNumber::rational(1), RealNumber::random()}, M.ring());
+    const auto z = N->gen(1) + 2 * N->one();
+
+    CAPTURE(z);
+
+    REQUIRE(Element(x).fma(y, z) == x + y * z);
+    REQUIRE(det2(x, z, y, z) == x * z - z * y);
+    REQUIRE(linear_combination<R>({x, y, z}, {z, z, x}) == x * z + y * z + z * x);
+  }
+
+  SECTION("Arithmetic with Many Terms") {
+    if (M.rank() > 1) {
+      const auto N = Module<R>::make({RealNumber::rational(1), RealNumber::random()}, M.ring());
+      const auto a = M.gen(M.rank() - 1) + N->gen(1) + N->one();
+
+      const auto x = a.pow(10);
+      const auto y = (a + 2 * N->one()).pow(6);
+
+      REQUIRE((x + y) * (x - y) == x * x - y * y);
+      REQUIRE(*(x * y).truediv(y) == x);
+      REQUIRE(*(x * y).truediv(x) == y);
+      REQUIRE(!(x * y + N->one()).truediv(y).has_value());
+    }
+  }
+
+  SECTION("Power") {
+    const auto x = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x);
+
+    REQUIRE(x.pow(0) == 1);
+
+    Element<R> expected = x;
+    for (unsigned int n = 1; n <= 6; n++) {
+      CAPTURE(n);
+      REQUIRE(x.pow(n) == expected);
+      expected *= x;
+    }
+  }
+
+  SECTION("Sum") {
+    const auto x = GENERATE_REF(elements<R>(M));
+    const auto y = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x, y);
+
+    std::vector<Element<R>> summands;
+    REQUIRE(sum(begin(summands), end(summands)) == 0);
+
+    summands.push_back(x);
+    REQUIRE(sum(begin(summands), end(summands)) == x);
+
+    summands.push_back(y);
+    REQUIRE(sum(begin(summands), end(summands)) == x + y);
+
+    // Summands from many different modules.
+    Element<R> expected = x + y;
+    for (int i = 0; i < 8; i++) {
+      const auto N = Module<R>::make({RealNumber::rational(1), RealNumber::random()}, M.ring());
+      summands.push_back(N->gen(1) + i * N->one());
+      expected += summands.back();
+    }
+
+    const auto total = sum(begin(summands), end(summands));
+    REQUIRE(total == expected);
+    if (x || y)
+      REQUIRE(*total.module() == *expected.module());
+
+    // Summands with distinct rational generators.
+    const auto g = RealNumber::random();
+    const auto A = Module<R>::make({RealNumber::rational(1), g}, M.ring());
+    const auto B = Module<R>::make({RealNumber::rational(2), g}, M.ring());
+    const auto C = Module<R>::make({RealNumber::rational(1)}, M.ring());
+    const auto D = Module<R>::make({RealNumber::rational(3)}, M.ring());
+
+    const std::vector<Element<R>> rationals = {A->gen(0) + A->gen(1), B->gen(0) + B->gen(1), C->gen(0)};
+    REQUIRE(sum(begin(rationals), end(rationals)) == 2 * A->gen(1) + 4 * A->one());
+
+    const std::vector<Element<R>> multiples = {B->gen(0), D->gen(0)};
+    REQUIRE(sum(begin(multiples), end(multiples)) == 5);
+  }
+
   SECTION("Simplification") {
     const auto x = GENERATE_REF(elements<R>(M));
 
@@ -469,6 +613,30 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
     }
   }
 
+  SECTION("Multivariate Division") {
+    const auto x = GENERATE_REF(elements<R>(M));
+    const auto y = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x, y);
+
+    if (y) {
+      REQUIRE(*(x * y).truediv(y) == x);
+      REQUIRE(*(x * y + y * y * y).truediv(y) == x + y * y);
+      REQUIRE(*(x * y).pow(3).truediv(y.pow(2)) == x.pow(3) * y);
+    }
+
+    // Quotients whose terms are found in an order that is not the order of
+    // the generators of their module.
+    const auto N = Module<R>::make({RealNumber::rational(1), RealNumber::random(), RealNumber::random()}, M.ring());
+    const auto a = N->gen(1) + 2 * N->one();
+    const auto b = N->gen(2) - N->gen(1);
+
+    REQUIRE(*(a * b).truediv(b) == a);
+    REQUIRE(*(a * a * b).truediv(b) == a * a);
+    REQUIRE(*(a * b * b).truediv(a) == b * b);
+    REQUIRE(!(a * b + N->one()).truediv(b).has_value());
+  }
+
   SECTION("Floor & Ceil") {
     const auto x = GENERATE_REF(elements<R>(M));
 
@@ -497,6 +665,18 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
     }
   }
 
+  SECTION("Conversion to Double") {
+    const auto x = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x);
+
+    // The double nearest to x lies within an ulp of any good enclosure of x.
+    const auto [lower, upper] = static_cast<std::pair<Arf, Arf>>(x.arb(64));
+    const double value = static_cast<double>(x);
+    REQUIRE(value >= std::nextafter(static_cast<double>(lower), -std::numeric_limits<double>::infinity()));
+    REQUIRE(value <= std::nextafter(static_cast<double>(upper), std::numeric_limits<double>::infinity()));
+  }
+
   SECTION("Hashing") {
     {
       const auto set = std::unordered_set{M.zero(), M.zero()};
@@ -507,6 +687,38 @@ TEMPLATE_TEST_CASE("Element", "[element]", IntegerRing, RationalField, NumberFie
       const auto set = std::unordered_set{M.zero(), M.one()};
       REQUIRE(set.size() == 2);
     }
+
+    if (M.rank()) {
+      // Coefficients that only differ in their higher limbs do not collide.
+      const mpz_class large = mpz_class(1) << 256;
+      const auto x = M.gen(0) * large;
+      const auto y = M.gen(0) * mpz_class(large + (mpz_class(1) << 128));
+      REQUIRE(std::hash<Element<R>>()(x) != std::hash<Element<R>>()(y));
+      if constexpr (!std::is_same_v<R, IntegerRing>)
+        REQUIRE(std::hash<Element<R>>()(x / 3) != std::hash<Element<R>>()(y / 3));
+    }
+
+    if constexpr (std::is_same_v<R, NumberField>) {
+      if (M.rank()) {
+        // Irrational coefficients do not collide.
+        const auto K = M.ring().parameters;
+        const auto x = M.gen(0) * eantic::renf_elem_class(*K, "a");
+        const auto y = M.gen(0) * eantic::renf_elem_class(*K, "2*a");
+        REQUIRE(std::hash<Element<R>>()(x) != std::hash<Element<R>>()(y));
+      }
+    }
+
+    const auto x = GENERATE_REF(elements<R>(M));
+
+    CAPTURE(x);
+
+    // Equal elements in different modules have the same hash.
+    const auto N = Module<R>::make({RealNumber::rational(1), RealNumber::random()}, M.ring());
+    const auto y = x + N->zero();
+    REQUIRE(y == x);
+    REQUIRE(&*y.module() != &*x.module());
+    REQUIRE(std::hash<Element<R>>()(y) == std::hash<Element<R>>()(x));
+    REQUIRE(std::unordered_set{x, y}.size() == 1);
   }
 
   if constexpr (!std::is_same_v<R, exactreal::IntegerRing>) {
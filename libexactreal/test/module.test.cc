@@ -19,6 +19,8 @@
  *********************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <thread>
+#include <vector>
 
 #include "../exact-real/element.hpp"
 #include "../exact-real/integer_ring.hpp"
@@ -39,6 +41,36 @@ TEMPLATE_TEST_CASE("Module", "[module]", IntegerRing, RationalField, NumberField
   SECTION("Uniqueness") {
     REQUIRE(&*Module<R>::make({}) == &*Module<R>::make({}));
     REQUIRE(&*Module<R>::make({RealNumber::random()}) != &*Module<R>::make({RealNumber::random()}));
+
+    // Generators can be given in any order.
+    const auto x = RealNumber::random();
+    const auto y = RealNumber::random();
+    REQUIRE(Module<R>::make({x, y}) == Module<R>::make({y, x}));
+    REQUIRE(Module<R>::make({*x * *y, RealNumber::rational(1), y}) == Module<R>::make({RealNumber::rational(1), y, *y * *x}));
+  }
+
+  SECTION("Uniqueness across Threads") {
+    const auto x = RealNumber::random();
+    const auto y = RealNumber::random();
+
+    std::vector<std::shared_ptr<const Module<R>>> modules(8);
+    std::vector<std::shared_ptr<const RealNumber>> products(modules.size());
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < modules.size(); t++) {
+      threads.emplace_back([&, t]() {
+        products[t] = (*x) * (*y);
+        modules[t] = Module<R>::make({RealNumber::rational(1), x, y, products[t]});
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    for (size_t t = 1; t < modules.size(); t++) {
+      REQUIRE(products[t] == products[0]);
+      REQUIRE(modules[t] == modules[0]);
+    }
   }
 
   SECTION("Rank") {
@@ -54,6 +86,37 @@ TEMPLATE_TEST_CASE("Module", "[module]", IntegerRing, RationalField, NumberField
     REQUIRE(m == n);
   }
 
+  SECTION("Index of Generators") {
+    const auto x = RealNumber::random();
+    const auto y = RealNumber::random();
+
+    const auto m = Module<R>::make({*x * *y, RealNumber::rational(1), x, y});
+
+    for (size i = 0; i < m->rank(); i++)
+      REQUIRE(m->index(*m->basis()[static_cast<size_t>(i)]) == i);
+
+    REQUIRE(!m->index(*RealNumber::rational(2)));
+    REQUIRE(!m->index(*(*x * *x)));
+    REQUIRE(!Module<R>::make({})->index(*x));
+
+    REQUIRE(Module<R>::make({x})->submodule(*m));
+    REQUIRE(!Module<R>::make({x, *x * *x})->submodule(*m));
+  }
+
+  SECTION("Validation of Generators") {
+    const auto x = RealNumber::random();
+    const auto y = RealNumber::random();
+
+    REQUIRE_THROWS(Module<R>::make({x, y, x}));
+    REQUIRE_THROWS(Module<R>::make({RealNumber::rational(1), x, RealNumber::rational(2)}));
+    REQUIRE_THROWS(Module<R>::make({*x * *y, x, *y * *x}));
+
+    // Spans cannot have two rational generators either.
+    REQUIRE_THROWS(Module<R>::span(Module<R>::make({RealNumber::rational(1), x}), Module<R>::make({RealNumber::rational(2), y})));
+
+    REQUIRE(Module<R>::make({*y * *x, RealNumber::rational(1), x, y})->rank() == 4);
+  }
+
   SECTION("Multiplication of Generators") {
     const auto m = Module<R>::make({RealNumber::random(), RealNumber::rational(1)});
     const auto n = Module<R>::make({RealNumber::rational(1)});
@@ -90,6 +153,18 @@ TEMPLATE_TEST_CASE("Module", "[module]", IntegerRing, RationalField, NumberField
 
     REQUIRE(span->rank() >= m.rank());
     REQUIRE(span->rank() >= n.rank());
+    REQUIRE(m.submodule(*span));
+    REQUIRE(n.submodule(*span));
+
+    // Spans are cached but they are the same module as before.
+    REQUIRE(Module<R>::span(m.shared_from_this(), n.shared_from_this()) == span);
+    REQUIRE(*Module<R>::span(n.shared_from_this(), m.shared_from_this()) == *span);
+
+    if (m.rank() && n.rank()) {
+      const auto x = m.gen(0) + n.gen(n.rank() - 1);
+      REQUIRE(x.module() == span);
+      REQUIRE(x - n.gen(n.rank() - 1) == m.gen(0));
+    }
   }
 
   if constexpr (std::is_same_v<R, NumberField>) {
@@ -18,9 +18,13 @@
  *  along with exact-real. If not, see <https://www.gnu.org/licenses/>.
  *********************************************************************/
 
+#include <thread>
+#include <vector>
+
 #include "../exact-real/arb.hpp"
 #include "../exact-real/arf.hpp"
 #include "../exact-real/real_number.hpp"
+#include "../exact-real/seed.hpp"
 #include "arf.test.hpp"
 #include "external/catch2/single_include/catch2/catch.hpp"
 
@@ -42,6 +46,105 @@ TEST_CASE("Random Real", "[real_number]") {
 
   SECTION("Conversion to Arf") {
     testArf(RealNumber::random());
+    testArf(RealNumber::random(Seed(1337, Seed::Generator::PHILOX)));
+  }
+
+  SECTION("Approximation Cache") {
+    std::vector<Arf> uncached;
+    RealNumber::approximationCacheLimits(0, 0);
+    for (long prec = 0; prec <= 1024; prec++)
+      uncached.push_back(rnd->arf(prec));
+
+    RealNumber::approximationCacheLimits(1 << 20, 1 << 26);
+    rnd->arf(2048);
+    for (long prec = 0; prec <= 1024; prec++)
+      REQUIRE(rnd->arf(prec) == uncached[prec]);
+  }
+
+  SECTION("Concurrent Approximation") {
+    std::vector<Arf> expected;
+    for (long prec = 0; prec <= 1024; prec++)
+      expected.push_back(rnd->arf(prec));
+
+    RealNumber::approximationCacheLimits(1 << 8, 1 << 12);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4);
+    std::vector<std::shared_ptr<const RealNumber>> others;
+    for (size_t t = 0; t < failures.size(); t++)
+      others.push_back(RealNumber::random());
+
+    for (size_t t = 0; t < failures.size(); t++) {
+      threads.emplace_back([&, t]() {
+        const auto& other = others[t];
+        for (long prec = 1024; prec >= 0; prec--) {
+          if (rnd->arf(prec) != expected[prec])
+            failures[t]++;
+          other->arf(prec + 1024 * static_cast<long>(t));
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    RealNumber::approximationCacheLimits(1 << 20, 1 << 26);
+
+    for (int f : failures)
+      REQUIRE(f == 0);
+  }
+
+  SECTION("Philox Generator") {
+    const auto x = RealNumber::random(Seed(1337, Seed::Generator::PHILOX));
+    REQUIRE(*x == *RealNumber::random(Seed(1337, Seed::Generator::PHILOX)));
+    REQUIRE(*x != *RealNumber::random(Seed(1337)));
+    REQUIRE(*x != *RealNumber::random(Seed(1338, Seed::Generator::PHILOX)));
+
+    // The first digits of the Philox-2x32-10 stream with key 1337.
+    REQUIRE(x->arf(63) == Arf(mpz_class("c781516c4ed3c7f3", 16), -64));
+  }
+
+  SECTION("Seed Streams") {
+    auto stream = Seed::stream(0);
+    const auto x = RealNumber::random(stream());
+    const auto y = RealNumber::random(stream());
+    REQUIRE(*x != *y);
+
+    // Streams are reproducible.
+    auto again = Seed::stream(0);
+    REQUIRE(*x == *RealNumber::random(again()));
+    REQUIRE(*y == *RealNumber::random(again()));
+
+    // Streams are distinct from each other and from the ordinary seeds.
+    REQUIRE(*x != *RealNumber::random(Seed::stream(1)()));
+    REQUIRE(*x != *RealNumber::random(Seed(0, Seed::Generator::PHILOX)));
+
+    REQUIRE_THROWS(Seed(0, Seed::Generator::RAND48, 1));
+
+    // Each thread gets the same reals from its stream as it would get
+    // without any other threads running.
+    std::vector<std::shared_ptr<const RealNumber>> expected;
+    for (unsigned int t = 0; t < 8; t++)
+      expected.push_back(RealNumber::random(Seed::stream(t)()));
+
+    std::vector<int> failures(8);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 8; t++) {
+      threads.emplace_back([&, t]() {
+        auto stream = Seed::stream(t);
+        if (RealNumber::random(stream()) != expected[t])
+          failures[t]++;
+        for (int i = 0; i < 64; i++)
+          RealNumber::random(stream())->arf(128);
+        // Seeds from the global counter are distinct in all threads.
+        Seed();
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    for (int f : failures)
+      REQUIRE(f == 0);
   }
 
   SECTION("Refine") {
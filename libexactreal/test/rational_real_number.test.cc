@@ -60,6 +60,15 @@ TEST_CASE("Rational Real Number", "[real_number][rational]") {
       }
     }
   }
+
+  SECTION("Uniqueness") {
+    // These rationals have the same double approximation.
+    const mpq_class epsilon = mpq_class(1) / (mpz_class(1) << 80);
+
+    REQUIRE(RealNumber::rational(1 + epsilon) == RealNumber::rational(1 + epsilon));
+    REQUIRE(RealNumber::rational(1 + epsilon) != RealNumber::rational(1 + 2 * epsilon));
+    REQUIRE(*RealNumber::rational(1 + epsilon) < *RealNumber::rational(1 + 2 * epsilon));
+  }
 }
 
 }  // namespace exactreal::test